@@ -7,8 +7,11 @@
 //============================================================================
 
 
+#include <algorithm>
 #include <ctime>
+#include <chrono>
 #include <iostream>
+#include <fstream>
 #include <vector>
 #include <stack>
 #include <cstdlib>
@@ -21,6 +24,15 @@
 #include "informed.h"
 #include "loadsave.h"
 #include "creator.h"
+#include "csr.h"
+#include "parallel.h"
+#include "bfs.h"
+#include "landmarks.h"
+#include "ch.h"
+#include "hublabels.h"
+#include "johnson.h"
+#include "apsp.h"
+#include "pathtree.h"
 
 using namespace std;
 
@@ -34,7 +46,9 @@ struct UserContex {
 	int Checked = 0;
 	int Processed = 0;
 	int SourceProcessingTimes = 0;
+	CsrGraph* CsrGraphPtr = nullptr;
 	UserContex (Settings* settings, Graph* graph, Vertex* source, Vertex* target): SettingsPtr(settings), GraphPtr(graph), SourceVertex(source), TargetVertex(target) {};
+	UserContex (Settings* settings, CsrGraph* graph): SettingsPtr(settings), CsrGraphPtr(graph) {};
 };
 
 static
@@ -49,61 +63,439 @@ void printGraph(Graph& graph) {
 	}
 }
 
-void handleAlgorithmEvent(AlgoEvent event, Vertex* vertex, void* user_context){
-	UserContex* alg_context = static_cast<UserContex*>(user_context);
+void printGraph(CsrGraph& graph) {
+	for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+		cout << graph.Names[v] << "->";
+		for (uint32_t i = graph.Offsets[v]; i < graph.Offsets[v + 1]; i++) {
+			cout << graph.Names[graph.Targets[i]] << "; ";
+		}
+		cout << endl;
+	}
+}
+
+//Common part of algorithm event handlers
+//name - name of the vertex the event is about (nullptr if the event is not about vertex)
+//is_source - true if the event is about source vertex
+//vertex_count - number of vertices in the graph
+void reportAlgorithmEvent(AlgoEvent event, const string* name, bool is_source, size_t vertex_count, UserContex* alg_context){
 	bool verbose = alg_context->SettingsPtr->Verbose;
 	switch(event) {
 	case AlgoEvent::VertexDiscovered:
 		alg_context->Checked++;
-		if (verbose) cout << "\t\tvertex discovered: " << vertex->Name << endl;
+		if (verbose) cout << "\t\tvertex discovered: " << *name << endl;
 		break;
 	case AlgoEvent::VertexProcessingStarted:
 		alg_context->Processed++;
-		if (verbose) cout << "\tprocessing started: " << vertex->Name << endl;
-		if (alg_context->SettingsPtr->SearchAlgorithm == Algorithm::BellmanFord && vertex == alg_context->SourceVertex) {
-			cout << "Iteration " << ++alg_context->SourceProcessingTimes << " of " << alg_context->GraphPtr->size() + 1 << endl;
+		if (verbose) cout << "\tprocessing started: " << *name << endl;
+		if (alg_context->SettingsPtr->SearchAlgorithm == Algorithm::BellmanFord && is_source) {
+			cout << "Iteration " << ++alg_context->SourceProcessingTimes << " of " << vertex_count + 1 << endl;
 		}
 		break;
 	case AlgoEvent::VertexProcessingFinished:
-		if (verbose) cout << "\tprocessing finished: " << vertex->Name << endl;
+		if (verbose) cout << "\tprocessing finished: " << *name << endl;
 		break;
 	case AlgoEvent::TargetFound:
-		cout << "target found: " << vertex->Name << endl;
+		cout << "target found: " << *name << endl;
 		break;
 	case AlgoEvent::TargetNotFound:
 		cout << "target not found. " << endl;
 		break;
 	case AlgoEvent::AlgorithmFinished:
-		if (alg_context->SettingsPtr->SearchAlgorithm != Algorithm::BellmanFord) {
+		if (alg_context->SettingsPtr->SearchAlgorithm != Algorithm::BellmanFord &&
+				alg_context->SettingsPtr->SearchAlgorithm != Algorithm::Spfa &&
+				alg_context->SettingsPtr->SearchAlgorithm != Algorithm::ParallelBellmanFord &&
+				alg_context->SettingsPtr->SearchAlgorithm != Algorithm::DeltaStepping &&
+				alg_context->SettingsPtr->SearchAlgorithm != Algorithm::ParallelBfs) {
 			cout << "Vertices checked: " << alg_context->Checked << ", processed: "
 					<< alg_context->Processed << endl;
 		}
 		break;
 	case AlgoEvent::NegativeLoopDetected:
-		cout << "Negative loop detected at " << vertex->Name << endl;
+		cout << "Negative loop detected at " << *name << endl;
+	}
+}
+
+void handleAlgorithmEvent(AlgoEvent event, Vertex* vertex, void* user_context){
+	UserContex* alg_context = static_cast<UserContex*>(user_context);
+	reportAlgorithmEvent(event, vertex ? &vertex->Name : nullptr, vertex && vertex == alg_context->SourceVertex,
+			alg_context->GraphPtr->size(), alg_context);
+}
+
+void handleCsrAlgorithmEvent(AlgoEvent event, uint32_t vertex, void* user_context){
+	UserContex* alg_context = static_cast<UserContex*>(user_context);
+	CsrGraph* graph = alg_context->CsrGraphPtr;
+	reportAlgorithmEvent(event, vertex != CSR_NO_VERTEX ? &graph->Names[vertex] : nullptr,
+			vertex != CSR_NO_VERTEX && graph->Names[vertex] == alg_context->SettingsPtr->SourceVertex,
+			graph->vertexCount(), alg_context);
+}
+
+//Prints paths to all vertices found by a single-source search, see writePathTree()
+void printPathsToAllVertices(Vertex* source, Graph& graph, SearchState& state, bool compact) {
+	vector<uint32_t> order;
+	vector<const string*> names(graph.idCount(), nullptr);
+	for (auto& pair : graph) {
+		order.push_back(pair.second->Id);
+		names[pair.second->Id] = &pair.second->Name;
+	}
+	writePathTree(cout, source->Id, state, order, names, compact);
+}
+
+void printPathsToAllVertices(uint32_t source, CsrGraph& graph, SearchState& state, bool compact) {
+	vector<uint32_t> order(graph.vertexCount());
+	vector<const string*> names(graph.vertexCount());
+	for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+		order[v] = v;
+		names[v] = &graph.Names[v];
+	}
+	writePathTree(cout, source, state, order, names, compact);
+}
+
+//Prints vertices of the negative loop found by Bellman-Ford family search, the loop is closed by the first vertex
+void printNegativeCycle(const vector<Vertex*>& cycle) {
+	if (cycle.empty()) return;
+	cout << "Negative loop: ";
+	for (Vertex* v : cycle) cout << v->Name << "->";
+	cout << cycle.front()->Name << "\n";
+}
+
+void printNegativeCycle(const CsrGraph& graph, const vector<uint32_t>& cycle) {
+	if (cycle.empty()) return;
+	cout << "Negative loop: ";
+	for (uint32_t v : cycle) cout << graph.Names[v] << "->";
+	cout << graph.Names[cycle.front()] << "\n";
+}
+
+//Prints the column vertices, then one line per row: row vertex and weights of paths to column vertices, "-" if there is no path
+void printDistanceMatrix(const CsrGraph& graph, const DistanceMatrix& matrix) {
+	cout << "Columns:";
+	for (uint32_t column : matrix.Columns) cout << " " << graph.Names[column];
+	cout << "\n";
+	for (uint32_t r = 0; r < matrix.rowCount(); r++) {
+		cout << graph.Names[matrix.Rows[r]] << ":";
+		for (uint32_t c = 0; c < matrix.columnCount(); c++) {
+			weight_t weight = matrix.at(r, c);
+			if (weight >= INFINITE_WEIGHT) cout << " -";
+			else cout << " " << weight;
+		}
+		cout << "\n";
+	}
+}
+
+//Prints the matrix or saves it to settings.MatrixFile
+void outputDistanceMatrix(const CsrGraph& graph, const Settings& settings, const DistanceMatrix& matrix) {
+	if (settings.MatrixFile.empty()) {
+		printDistanceMatrix(graph, matrix);
+		return;
+	}
+	if (saveDistanceMatrix(matrix, settings.MatrixFile) != NO_ERROR) cerr << "Failed to save distance matrix to " << settings.MatrixFile << endl;
+	else cout << "Distance matrix saved to " << settings.MatrixFile << endl;
+}
+
+//Reads sources and targets of many-to-many query: vertex names separated by whitespace, "sources:" and "targets:" keywords
+//switch the list the following names go to
+//Returns false if the file cannot be read or has unknown vertices
+bool readMatrixQuery(const CsrGraph& graph, const string& path, vector<uint32_t>& sources, vector<uint32_t>& targets) {
+	ifstream file(path);
+	if (!file) {
+		cerr << "Cannot open query file " << path << endl;
+		return false;
+	}
+	vector<uint32_t>* list = nullptr;
+	string word;
+	while (file >> word) {
+		if (word == "sources:") list = &sources;
+		else if (word == "targets:") list = &targets;
+		else if (!list) {
+			cerr << "Query file must start with \"sources:\" or \"targets:\"" << endl;
+			return false;
+		}
+		else {
+			uint32_t v = graph.findVertex(word);
+			if (v == CSR_NO_VERTEX) {
+				cerr << "Unknown vertex in query file: " << word << endl;
+				return false;
+			}
+			list->push_back(v);
+		}
+	}
+	return true;
+}
+
+//Checks whether the settings ask for a distance matrix instead of a path: such a run has no queries to benchmark
+bool isMatrixQuery(const Settings& settings) {
+	return settings.SearchAlgorithm == Algorithm::AllPairs ||
+			(settings.SearchAlgorithm == Algorithm::ContractionHierarchies && !settings.QueryFile.empty());
+}
+
+const char* apspMethodName(ApspMethod method) {
+	switch (method) {
+	case ApspMethod::FloydWarshall: return "blocked Floyd-Warshall";
+	case ApspMethod::Dijkstra: return "Dijkstra search from every vertex";
+	default: return "auto";
+	}
+}
+
+//Checks whether the algorithm finds path in two parts: from source and from target
+bool isBidirectional(Algorithm algorithm) {
+	return algorithm == Algorithm::FastDijkstra || algorithm == Algorithm::BidirectionalBfs || algorithm == Algorithm::BidirectionalAlt;
+}
+
+//Prints result of the algorithm that is not about found path
+void printResultCode(AlgoResultCode code) {
+	switch (code) {
+	case AlgoResultCode::NoSourceOrTarget:
+		cout << "\tSource or target vertices are not defined." << endl;
+		break;
+	case AlgoResultCode::SourceIsTarget:
+		cout << "\tSource and target are the same vertex." << endl;
+		break;
+	case AlgoResultCode::NotFound:
+		cout << "A path from source to target has not been found." << endl;
+		break;
+	case AlgoResultCode::NegativeLoopFound:
+		cout << "Negative loop was detected and algorithm execution stopped." << endl;
+		break;
+	default: break;
+	}
+}
+
+//Configures search workspace according to settings.
+//Radix heap needs non-negative integer edge weights, 4-ary heap is used instead if the graph has other weights.
+template <class AnyGraph>
+void setupWorkspace(QueryWorkspace& workspace, const Settings& settings, const AnyGraph& graph) {
+	workspace.Insertion = settings.LazyQueue ? QueueInsertion::Lazy : QueueInsertion::Eager;
+	workspace.Queue = settings.Queue;
+	if (workspace.Queue == QueueType::Radix && !hasNonNegativeIntegerWeights(graph)) {
+		cout << "Radix heap requires non-negative integer weights, 4-ary heap is used instead." << endl;
+		workspace.Queue = QueueType::DaryHeap;
+	}
+}
+
+void printBfsCounters(const BfsResult& result) {
+	cout << "Edges examined: " << result.EdgesExamined << " (top-down search: " << result.TopDownEdges << "), top-down steps: "
+			<< result.TopDownSteps << ", bottom-up steps: " << result.BottomUpSteps << endl;
+}
+
+const char* heuristicName(HeuristicType heuristic) {
+	switch (heuristic) {
+	case HeuristicType::Manhattan: return "manhattan";
+	case HeuristicType::Octile: return "octile";
+	case HeuristicType::Euclidean: return "euclidean";
+	default: return "zero";
+	}
+}
+
+bool is2d(const Graph& graph) {
+	return graph.begin() != graph.end() && dynamic_cast<Vertex2d*>(graph.begin()->second) != nullptr;
+}
+
+bool is2d(const CsrGraph& graph) {
+	return graph.is2d();
+}
+
+//Heuristic of A* search for the graph: auto means Manhattan for 2d graph and zero otherwise.
+//Coordinate heuristics need 2d graph, zero heuristic is used instead on other graphs.
+HeuristicType selectHeuristic(HeuristicType heuristic, bool is_2d) {
+	if (heuristic == HeuristicType::Auto) return is_2d ? HeuristicType::Manhattan : HeuristicType::Zero;
+	if (heuristic != HeuristicType::Zero && !is_2d) {
+		cout << "Graph vertices have no coordinates, zero heuristic is used instead of " << heuristicName(heuristic) << "." << endl;
+		return HeuristicType::Zero;
 	}
+	return heuristic;
 }
 
-void printPathsToAllVertices(Vertex* source, Graph& graph) {
-	stack<Vertex*> st;
-	for (auto &pair: graph) {
-		Vertex* current_vertex = pair.second;
-		DijkstraContext* context = static_cast<DijkstraContext*>(current_vertex->Context);
-		if (context->Weight == INFINITE_WEIGHT) {
-			cout << current_vertex->Name << ": no path from source to this vertex\n";
-			continue;
+//The largest scale of coordinate heuristic that keeps it consistent on the graph, so that A* finds minimal weight paths
+template <class AnyGraph>
+weight_t heuristicScale(HeuristicType heuristic, const AnyGraph& graph) {
+	switch (heuristic) {
+	case HeuristicType::Manhattan: return minWeightPerDistance<ManhattanDistance>(graph);
+	case HeuristicType::Octile: return minWeightPerDistance<OctileDistance>(graph);
+	case HeuristicType::Euclidean: return minWeightPerDistance<EuclideanDistance>(graph);
+	default: return 0;
+	}
+}
+
+//Calls search(h) with heuristic h of given type and scale
+template <class Search>
+void withHeuristic(HeuristicType heuristic, weight_t scale, Search search) {
+	switch (heuristic) {
+	case HeuristicType::Manhattan: search(ManhattanHeuristic{scale}); break;
+	case HeuristicType::Octile: search(OctileHeuristic{scale}); break;
+	case HeuristicType::Euclidean: search(EuclideanHeuristic{scale}); break;
+	default: search(ZeroHeuristic()); break;
+	}
+}
+
+void reportHeuristic(HeuristicType heuristic, weight_t scale, bool verbose) {
+	if (verbose) cout << "\theuristic: " << heuristicName(heuristic) << ", scale: " << scale << endl;
+}
+
+//Landmarks of ALT search. Table saved next to the graph file is used if it is found, otherwise landmarks are selected.
+//With --preprocess landmarks are always selected and the table is saved next to the graph file.
+//Returns false if landmarks cannot be selected
+bool prepareLandmarks(const CsrGraph& graph, const Settings& settings, LandmarkTable& table) {
+	string path = settings.FilePath + ".landmarks";
+	if (settings.LoadFromFile && !settings.Preprocess) {
+		int err = loadLandmarks(table, graph, path);
+		if (err == NO_ERROR) {
+			cout << "Landmarks loaded from " << path << ": " << table.landmarkCount() << endl;
+			return true;
+		}
+		if (err == FATAL_ERROR_PREPROCESSED_DATA_MISMATCH) {
+			cout << "Landmarks in " << path << " were selected for another graph." << endl;
+		}
+	}
+
+	auto start = chrono::steady_clock::now();
+	if (!selectLandmarks(graph, settings.LandmarkCount, settings.Landmarks, table)) {
+		cout << "Landmarks require non-negative edge weights." << endl;
+		return false;
+	}
+	chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+	cout << "Landmarks selected: " << table.landmarkCount() << endl;
+	if (settings.Verbose) {
+		cout << "\tpreprocessing time: " << elapsed.count() << " ms, table size: "
+				<< (table.FromLandmark.size() + table.ToLandmark.size()) * sizeof(weight_t) << " bytes" << endl;
+	}
+	if (settings.Preprocess) {
+		int err = saveLandmarks(table, graph, path);
+		if (err != NO_ERROR) cerr << "Failed to save landmarks to " << path << endl;
+		else cout << "Landmarks saved to " << path << endl;
+	}
+	return true;
+}
+
+//Contraction hierarchy of the graph. Hierarchy saved next to the graph file is used if it is found, otherwise it is built.
+//With --preprocess the hierarchy is always built and saved next to the graph file.
+//Returns false if the hierarchy cannot be built
+bool prepareHierarchy(const CsrGraph& graph, const Settings& settings, ContractionHierarchy& hierarchy) {
+	string path = settings.FilePath + ".ch";
+	if (settings.LoadFromFile && !settings.Preprocess) {
+		int err = loadContractionHierarchy(hierarchy, graph, path);
+		if (err == NO_ERROR) {
+			cout << "Contraction hierarchy loaded from " << path << ": " << hierarchy.shortcutCount() << " shortcuts" << endl;
+			return true;
+		}
+		if (err == FATAL_ERROR_PREPROCESSED_DATA_MISMATCH) {
+			cout << "Contraction hierarchy in " << path << " was built for another graph." << endl;
 		}
-		Vertex *vertex = current_vertex;
-		while (vertex != source) {
-			st.push(vertex);
-			vertex = static_cast<DijkstraContext*>(vertex->Context)->Parent;
+	}
+
+	auto start = chrono::steady_clock::now();
+	if (!buildContractionHierarchy(graph, hierarchy)) {
+		cout << "Contraction hierarchy requires non-negative edge weights." << endl;
+		return false;
+	}
+	chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+	cout << "Contraction hierarchy built: " << hierarchy.shortcutCount() << " shortcuts" << endl;
+	if (settings.Verbose) {
+		size_t edges = hierarchy.edgeCount();
+		cout << "\tpreprocessing time: " << elapsed.count() << " ms, hierarchy size: "
+				<< hierarchy.vertexCount() * 3 * sizeof(uint32_t) + edges * (2 * sizeof(uint32_t) + sizeof(weight_t)) << " bytes" << endl;
+	}
+	if (settings.Preprocess) {
+		int err = saveContractionHierarchy(hierarchy, graph, path);
+		if (err != NO_ERROR) cerr << "Failed to save contraction hierarchy to " << path << endl;
+		else cout << "Contraction hierarchy saved to " << path << endl;
+	}
+	return true;
+}
+
+//Label size report: lets compare hub labels with other preprocessing
+void reportHubLabels(const HubLabels& labels) {
+	cout << "\tlabel entries: " << labels.entryCount() << ", per vertex: "
+			<< (labels.vertexCount() > 0 ? double(labels.entryCount()) / labels.vertexCount() : 0)
+			<< " (max " << labels.maxLabelSize() << "), memory: " << labels.memorySize() << " bytes" << endl;
+}
+
+//Hub labels of the graph. Labels saved next to the graph file are used if they are found, otherwise they are built.
+//With --preprocess labels are always built and saved next to the graph file.
+//Returns false if labels cannot be built
+bool prepareHubLabels(const CsrGraph& graph, const Settings& settings, HubLabels& labels) {
+	string path = settings.FilePath + ".hublabels";
+	if (settings.LoadFromFile && !settings.Preprocess) {
+		int err = loadHubLabels(labels, graph, path);
+		if (err == NO_ERROR) {
+			cout << "Hub labels loaded from " << path << endl;
+			reportHubLabels(labels);
+			return true;
+		}
+		if (err == FATAL_ERROR_PREPROCESSED_DATA_MISMATCH) {
+			cout << "Hub labels in " << path << " were built for another graph." << endl;
+		}
+	}
+
+	auto start = chrono::steady_clock::now();
+	if (!buildHubLabels(graph, labels)) {
+		cout << "Hub labels require non-negative edge weights." << endl;
+		return false;
+	}
+	chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+	cout << "Hub labels built" << endl;
+	reportHubLabels(labels);
+	if (settings.Verbose) cout << "\tpreprocessing time: " << elapsed.count() << " ms" << endl;
+	if (settings.Preprocess) {
+		int err = saveHubLabels(labels, graph, path);
+		if (err != NO_ERROR) cerr << "Failed to save hub labels to " << path << endl;
+		else cout << "Hub labels saved to " << path << endl;
+	}
+	return true;
+}
+
+//Johnson's potentials of the graph. Potentials saved next to the graph file are used if they are found, otherwise they are computed.
+//With --preprocess potentials are always computed and saved next to the graph file.
+//Then weights of the graph are replaced with reduced ones, so the graph keeps them for all following searches.
+//Returns false if the graph has a negative loop
+bool prepareReweighting(CsrGraph& graph, const Settings& settings, JohnsonPotentials& potentials) {
+	string path = settings.FilePath + ".potentials";
+	bool loaded = false;
+	if (settings.LoadFromFile && !settings.Preprocess) {
+		int err = loadPotentials(potentials, graph, path);
+		if (err == NO_ERROR) {
+			cout << "Potentials loaded from " << path << endl;
+			loaded = true;
+		}
+		else if (err == FATAL_ERROR_PREPROCESSED_DATA_MISMATCH) {
+			cout << "Potentials in " << path << " were computed for another graph." << endl;
+		}
+	}
+
+	if (!loaded) {
+		auto start = chrono::steady_clock::now();
+		vector<uint32_t> cycle;
+		if (!computePotentials(graph, potentials, cycle)) {
+			cout << "Graph cannot be reweighted: it has a negative loop." << endl;
+			printNegativeCycle(graph, cycle);
+			return false;
 		}
-		cout << source->Name;
-		while (!st.empty()) {
-			cout << "->" << st.top()->Name;
-			st.pop();
+		chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+		cout << "Potentials computed" << endl;
+		if (settings.Verbose) cout << "\tpreprocessing time: " << elapsed.count() << " ms" << endl;
+		if (settings.Preprocess) {
+			int err = savePotentials(potentials, graph, path);
+			if (err != NO_ERROR) cerr << "Failed to save potentials to " << path << endl;
+			else cout << "Potentials saved to " << path << endl;
 		}
-		cout << " weight: " << static_cast<DijkstraContext*>(current_vertex->Context)->Weight << "\n";
+	}
+	reweightGraph(graph, potentials);
+	return true;
+}
+
+//Checks whether the algorithm keeps path weights in the workspace (BFS family keeps numbers of transitions there)
+bool keepsPathWeights(Algorithm algorithm) {
+	return algorithm != Algorithm::BreadthFirstSearch && algorithm != Algorithm::DepthFirstSearch &&
+			algorithm != Algorithm::DirectionOptimizingBfs && algorithm != Algorithm::ParallelBfs &&
+			algorithm != Algorithm::BidirectionalBfs;
+}
+
+//Checks whether the algorithm is one of Bellman-Ford family searches: they allow negative edge weights themselves
+bool isBellmanFordFamily(Algorithm algorithm) {
+	return algorithm == Algorithm::BellmanFord || algorithm == Algorithm::Spfa || algorithm == Algorithm::ParallelBellmanFord;
+}
+
+void reportDialEligibility(weight_t max_edge_weight) {
+	if (max_edge_weight < 0) {
+		cout << "Edge weights are not integers in range 0.." << DIAL_MAX_EDGE_WEIGHT << ", binary heap is used instead of buckets." << endl;
 	}
 }
 
@@ -111,9 +503,18 @@ void applyAlgo(Graph& graph, Settings &settings) {
 	if (settings.SearchAlgorithm == Algorithm::None) return;
 	Vertex *source = findVertex(settings.SourceVertex, graph);
 	Vertex *target = findVertex(settings.TargetVertex, graph);
+	//Search without target (paths to all vertices) is run only when no target is given
+	if (!settings.TargetVertex.empty() && !target) {
+		printResultCode(AlgoResultCode::NoSourceOrTarget);
+		return;
+	}
 	UserContex user_context(&settings, &graph, source, target);
 	AlgoResult result;
 	BidirectionalDijkstraResult fast_dijkstra_result;
+	BfsResult bfs_result;
+	BellmanFordResult bellman_ford_result;
+	QueryWorkspace workspace;
+	setupWorkspace(workspace, settings, graph);
 
 	switch (settings.SearchAlgorithm) {
 	case Algorithm::BreadthFirstSearch: {
@@ -128,48 +529,77 @@ void applyAlgo(Graph& graph, Settings &settings) {
 	}
 	case Algorithm::Dijkstra: {
 		cout << "Applying Dijkstra minimal weight path search..." << endl;
-		dijkstra(source, target, graph, handleAlgorithmEvent, result, &user_context);
+		dijkstra(source, target, graph, workspace, handleAlgorithmEvent, result, &user_context);
 		break;
 	}
 	case Algorithm::BellmanFord: {
 		cout << "Applying Bellman-Ford minimal weight path search..." << endl;
-		bellmanFord(source, target, graph, handleAlgorithmEvent, result, &user_context);
+		bellmanFord(source, target, graph, workspace, handleAlgorithmEvent, bellman_ford_result, &user_context);
+		result = bellman_ford_result;
 		if (result.ResultCode == AlgoResultCode::Found || result.ResultCode == AlgoResultCode::NotFound) {
-			printPathsToAllVertices(source, graph);
+			printPathsToAllVertices(source, graph, workspace.Forward, settings.CompactPaths);
 		}
+		printNegativeCycle(bellman_ford_result.NegativeCycle);
+		break;
+	}
+	case Algorithm::Spfa: {
+		cout << "Applying SPFA (queue-based Bellman-Ford) minimal weight path search..." << endl;
+		spfa(source, target, graph, workspace, handleAlgorithmEvent, bellman_ford_result, &user_context);
+		result = bellman_ford_result;
+		if (result.ResultCode == AlgoResultCode::Found || result.ResultCode == AlgoResultCode::NotFound) {
+			printPathsToAllVertices(source, graph, workspace.Forward, settings.CompactPaths);
+		}
+		printNegativeCycle(bellman_ford_result.NegativeCycle);
 		break;
 	}
 	case Algorithm::FastDijkstra:
 		cout << "Applying Bidirectional Dijkstra minimal weight path search..." << endl;
-		bidirectionalDijkstra(source, target, graph, handleAlgorithmEvent, fast_dijkstra_result, &user_context);
+		bidirectionalDijkstra(source, target, graph, workspace, handleAlgorithmEvent, fast_dijkstra_result, &user_context);
+		result = fast_dijkstra_result;
+		break;
+	case Algorithm::BidirectionalBfs:
+		cout << "Applying bidirectional breadth-first search..." << endl;
+		bidirectionalBfs(source, target, graph, workspace, handleAlgorithmEvent, fast_dijkstra_result, &user_context);
 		result = fast_dijkstra_result;
 		break;
 	case Algorithm::Dijkstra2D: {
 		cout << "Applying Dijkstra2D minimal weight path search..." << endl;
-		dijkstra2d(static_cast<Vertex2d*>(source), static_cast<Vertex2d*>(target), graph, handleAlgorithmEvent, result, &user_context);
+		dijkstra2d(static_cast<Vertex2d*>(source), static_cast<Vertex2d*>(target), graph, workspace, handleAlgorithmEvent, result, &user_context);
 		break;
 	}
+	case Algorithm::DialDijkstra: {
+		cout << "Applying Dial's bucket Dijkstra minimal weight path search..." << endl;
+		weight_t max_edge_weight = dialMaxEdgeWeight(graph);
+		reportDialEligibility(max_edge_weight);
+		dialDijkstra(source, target, graph, workspace, max_edge_weight, handleAlgorithmEvent, result, &user_context);
+		break;
+	}
+	case Algorithm::AStar: {
+		cout << "Applying A* minimal weight path search..." << endl;
+		HeuristicType heuristic = selectHeuristic(settings.Heuristic, is2d(graph));
+		weight_t scale = heuristicScale(heuristic, graph);
+		reportHeuristic(heuristic, scale, settings.Verbose);
+		withHeuristic(heuristic, scale, [&](const auto& h) {
+			aStar(source, target, graph, workspace, h, handleAlgorithmEvent, result, &user_context);
+		});
+		break;
+	}
+	case Algorithm::DirectionOptimizingBfs:
+		cout << "Applying direction-optimizing breadth-first search..." << endl;
+		directionOptimizingBfs(source ? source->Id : NO_VERTEX_ID, target ? target->Id : NO_VERTEX_ID, graph, workspace,
+				handleAlgorithmEvent, bfs_result, &user_context);
+		printBfsCounters(bfs_result);
+		result = bfs_result;
+		break;
 	default: return;
 	}
 
 	switch (result.ResultCode) {
-	case AlgoResultCode::NoSourceOrTarget:
-		cout << "\tSource or target vertices are not defined." << endl;
-		break;
-	case AlgoResultCode::SourceIsTarget:
-		cout << "\tSource and target are the same vertex." << endl;
-		break;
-	case AlgoResultCode::NotFound:
-		cout << "A path from source to target has not been found." << endl;
-		break;
-	case AlgoResultCode::NegativeLoopFound:
-		cout << "Negative loop was detected and algorithm execution stopped." << endl;
-		break;
 	case AlgoResultCode::Found: {
 		cout << "The path from source to target has been found: " << endl;
 
 		Vertex *v = target;
-		if (settings.SearchAlgorithm == Algorithm::FastDijkstra) {
+		if (isBidirectional(settings.SearchAlgorithm)) {
 			v = fast_dijkstra_result.ForwardSearchLastVertex;
 		}
 		stack<Vertex*> path;
@@ -179,14 +609,19 @@ void applyAlgo(Graph& graph, Settings &settings) {
 			case Algorithm::Dijkstra:
 			case Algorithm::Dijkstra2D:
 			case Algorithm::BellmanFord:
-				v = static_cast<DijkstraContext*>(v->Context)->Parent;
+			case Algorithm::Spfa:
+			case Algorithm::DialDijkstra:
+			case Algorithm::DirectionOptimizingBfs:
+			case Algorithm::AStar:
+				v = graph.VerticesById[workspace.Forward.parent(v->Id)];
 				break;
 			case Algorithm::BreadthFirstSearch:
 			case Algorithm::DepthFirstSearch:
 				v = static_cast<Vertex*>(v->Context);
 				break;
 			case Algorithm::FastDijkstra:
-				v = static_cast<BidirectionalDijkstraContext*>(v->Context)->ParentInForwardSearch;
+			case Algorithm::BidirectionalBfs:
+				v = graph.VerticesById[workspace.Forward.parent(v->Id)];
 				break;
 			default:
 				break;
@@ -200,11 +635,11 @@ void applyAlgo(Graph& graph, Settings &settings) {
 			path.pop();
 		}
 
-		if (settings.SearchAlgorithm == Algorithm::FastDijkstra) {
+		if (isBidirectional(settings.SearchAlgorithm)) {
 			v = fast_dijkstra_result.BackwardSearchLastVertex;
 			cout << v->Name << ";";
 			while (v != target) {
-				v = static_cast<BidirectionalDijkstraContext*>(v->Context)->ParentInBackwardSearch;
+				v = graph.VerticesById[workspace.Backward.parent(v->Id)];
 				cout << v->Name << ";";
 			}
 		}
@@ -213,16 +648,21 @@ void applyAlgo(Graph& graph, Settings &settings) {
 		switch(settings.SearchAlgorithm) {
 		case Algorithm::Dijkstra:
 		case Algorithm::BellmanFord:
-			cout << static_cast<DijkstraContext*>(target->Context)->Weight;
+		case Algorithm::Spfa:
+		case Algorithm::DialDijkstra:
+		case Algorithm::AStar:
+			cout << workspace.Forward.weight(target->Id);
 			break;
 		case Algorithm::Dijkstra2D:
 		case Algorithm::BreadthFirstSearch:
 		case Algorithm::DepthFirstSearch:
+		case Algorithm::DirectionOptimizingBfs:
+		case Algorithm::BidirectionalBfs:
 			cout << "unknown (used algorithm is not capable to detect path of lowest weight)\n";
 			break;
 		case Algorithm::FastDijkstra:
-			cout << static_cast<BidirectionalDijkstraContext*>(fast_dijkstra_result.ForwardSearchLastVertex->Context)->WeightInForwardSearch +
-				static_cast<BidirectionalDijkstraContext*>(fast_dijkstra_result.BackwardSearchLastVertex->Context)->WeightInBackwardSearch +
+			cout << workspace.Forward.weight(fast_dijkstra_result.ForwardSearchLastVertex->Id) +
+				workspace.Backward.weight(fast_dijkstra_result.BackwardSearchLastVertex->Id) +
 				fast_dijkstra_result.ConnectingEdgeWeight << "\n";
 			break;
 		default:
@@ -230,8 +670,522 @@ void applyAlgo(Graph& graph, Settings &settings) {
 		}
 		break;
 	}
-	default: break;
+	//Dijkstra searches label all vertices when target is not given
+	case AlgoResultCode::Ok:
+		printPathsToAllVertices(source, graph, workspace.Forward, settings.CompactPaths);
+		break;
+	default:
+		printResultCode(result.ResultCode);
+		break;
+	}
+}
+
+//potentials - potentials the graph is reweighted with, nullptr if it has original weights
+void applyCsrAlgo(CsrGraph& graph, Settings &settings, const JohnsonPotentials* potentials = nullptr) {
+	if (settings.SearchAlgorithm == Algorithm::None) return;
+	uint32_t source = graph.findVertex(settings.SourceVertex);
+	uint32_t target = graph.findVertex(settings.TargetVertex);
+	//Search without target (paths to all vertices) is run only when no target is given
+	if (!settings.TargetVertex.empty() && target == CSR_NO_VERTEX) {
+		printResultCode(AlgoResultCode::NoSourceOrTarget);
+		return;
+	}
+	UserContex user_context(&settings, &graph);
+	QueryWorkspace workspace;
+	setupWorkspace(workspace, settings, graph);
+	AlgoResult result;
+	CsrBidirectionalResult fast_dijkstra_result;
+	BfsResult bfs_result;
+	CsrBellmanFordResult bellman_ford_result;
+
+	switch (settings.SearchAlgorithm) {
+	case Algorithm::BreadthFirstSearch:
+		cout << "Applying breadth-first search..." << endl;
+		bfs(graph, source, target, workspace, handleCsrAlgorithmEvent, result, &user_context);
+		break;
+	case Algorithm::DepthFirstSearch:
+		cout << "Applying depth-first search..." << endl;
+		dfs(graph, source, target, workspace, handleCsrAlgorithmEvent, result, &user_context);
+		break;
+	case Algorithm::Dijkstra:
+		cout << "Applying Dijkstra minimal weight path search..." << endl;
+		dijkstra(graph, source, target, workspace, handleCsrAlgorithmEvent, result, &user_context);
+		break;
+	case Algorithm::BellmanFord:
+		cout << "Applying Bellman-Ford minimal weight path search..." << endl;
+		bellmanFord(graph, source, target, workspace, handleCsrAlgorithmEvent, bellman_ford_result, &user_context);
+		result = bellman_ford_result;
+		if (result.ResultCode == AlgoResultCode::Found || result.ResultCode == AlgoResultCode::NotFound) {
+			printPathsToAllVertices(source, graph, workspace.Forward, settings.CompactPaths);
+		}
+		printNegativeCycle(graph, bellman_ford_result.NegativeCycle);
+		break;
+	case Algorithm::Spfa:
+		cout << "Applying SPFA (queue-based Bellman-Ford) minimal weight path search..." << endl;
+		spfa(graph, source, target, workspace, handleCsrAlgorithmEvent, bellman_ford_result, &user_context);
+		result = bellman_ford_result;
+		if (result.ResultCode == AlgoResultCode::Found || result.ResultCode == AlgoResultCode::NotFound) {
+			printPathsToAllVertices(source, graph, workspace.Forward, settings.CompactPaths);
+		}
+		printNegativeCycle(graph, bellman_ford_result.NegativeCycle);
+		break;
+	case Algorithm::FastDijkstra:
+		cout << "Applying Bidirectional Dijkstra minimal weight path search..." << endl;
+		bidirectionalDijkstra(graph, source, target, workspace, handleCsrAlgorithmEvent, fast_dijkstra_result, &user_context);
+		result = fast_dijkstra_result;
+		break;
+	case Algorithm::BidirectionalBfs:
+		cout << "Applying bidirectional breadth-first search..." << endl;
+		bidirectionalBfs(graph, source, target, workspace, handleCsrAlgorithmEvent, fast_dijkstra_result, &user_context);
+		result = fast_dijkstra_result;
+		break;
+	case Algorithm::Dijkstra2D:
+		cout << "Applying Dijkstra2D minimal weight path search..." << endl;
+		dijkstra2d(graph, source, target, workspace, handleCsrAlgorithmEvent, result, &user_context);
+		break;
+	case Algorithm::DialDijkstra: {
+		cout << "Applying Dial's bucket Dijkstra minimal weight path search..." << endl;
+		weight_t max_edge_weight = dialMaxEdgeWeight(graph);
+		reportDialEligibility(max_edge_weight);
+		dialDijkstra(graph, source, target, workspace, max_edge_weight, handleCsrAlgorithmEvent, result, &user_context);
+		break;
+	}
+	case Algorithm::DeltaStepping: {
+		cout << "Applying parallel delta-stepping minimal weight path search..." << endl;
+		ThreadPool pool(settings.Threads);
+		if (settings.Verbose) cout << "\tthreads: " << pool.size() << endl;
+		if (!graph.Weights.empty() && *min_element(graph.Weights.begin(), graph.Weights.end()) < 0) {
+			cout << "Graph has negative edge weights, parallel Bellman-Ford is run instead of delta-stepping." << endl;
+		}
+		deltaStepping(graph, source, target, workspace, pool, settings.Delta, handleCsrAlgorithmEvent, result, &user_context);
+		break;
+	}
+	case Algorithm::ParallelBfs: {
+		cout << "Applying parallel breadth-first search..." << endl;
+		ThreadPool pool(settings.Threads);
+		if (settings.Verbose) cout << "\tthreads: " << pool.size() << endl;
+		parallelBfs(graph, source, target, workspace, pool, handleCsrAlgorithmEvent, result, &user_context);
+		break;
+	}
+	case Algorithm::ParallelBellmanFord: {
+		cout << "Applying parallel Bellman-Ford minimal weight path search..." << endl;
+		ThreadPool pool(settings.Threads);
+		if (settings.Verbose) cout << "\tthreads: " << pool.size() << endl;
+		parallelBellmanFord(graph, source, target, workspace, pool, handleCsrAlgorithmEvent, bellman_ford_result, &user_context);
+		result = bellman_ford_result;
+		if (result.ResultCode == AlgoResultCode::Found || result.ResultCode == AlgoResultCode::NotFound) {
+			printPathsToAllVertices(source, graph, workspace.Forward, settings.CompactPaths);
+		}
+		printNegativeCycle(graph, bellman_ford_result.NegativeCycle);
+		break;
+	}
+	case Algorithm::AStar: {
+		cout << "Applying A* minimal weight path search..." << endl;
+		HeuristicType heuristic = selectHeuristic(settings.Heuristic, is2d(graph));
+		weight_t scale = heuristicScale(heuristic, graph);
+		reportHeuristic(heuristic, scale, settings.Verbose);
+		withHeuristic(heuristic, scale, [&](const auto& h) {
+			aStar(graph, source, target, workspace, h, handleCsrAlgorithmEvent, result, &user_context);
+		});
+		break;
+	}
+	case Algorithm::Alt: {
+		LandmarkTable landmarks;
+		if (!prepareLandmarks(graph, settings, landmarks)) return;
+		cout << "Applying ALT minimal weight path search..." << endl;
+		altSearch(graph, landmarks, source, target, workspace, handleCsrAlgorithmEvent, result, &user_context);
+		break;
+	}
+	case Algorithm::BidirectionalAlt: {
+		LandmarkTable landmarks;
+		if (!prepareLandmarks(graph, settings, landmarks)) return;
+		cout << "Applying bidirectional ALT minimal weight path search..." << endl;
+		bidirectionalAlt(graph, landmarks, source, target, workspace, handleCsrAlgorithmEvent, fast_dijkstra_result, &user_context);
+		result = fast_dijkstra_result;
+		break;
+	}
+	case Algorithm::ContractionHierarchies: {
+		ContractionHierarchy hierarchy;
+		if (!prepareHierarchy(graph, settings, hierarchy)) return;
+		if (!settings.QueryFile.empty()) {
+			vector<uint32_t> sources, targets;
+			if (!readMatrixQuery(graph, settings.QueryFile, sources, targets)) return;
+			cout << "Applying bucket-based many-to-many search: " << sources.size() << " sources, " << targets.size() << " targets..." << endl;
+			ThreadPool pool(settings.Threads);
+			DistanceMatrix matrix;
+			auto start = chrono::steady_clock::now();
+			distanceMatrix(hierarchy, pool, sources, targets, matrix);
+			chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+			if (settings.Verbose) cout << "\tthreads: " << pool.size() << endl;
+			if (settings.Verbose || settings.BenchmarkQueries > 0) cout << "\ttotal time: " << elapsed.count() << " ms" << endl;
+			if (potentials) {
+				for (uint32_t r = 0; r < matrix.rowCount(); r++) {
+					for (uint32_t c = 0; c < matrix.columnCount(); c++) {
+						weight_t& weight = matrix.Weights[size_t(r) * matrix.columnCount() + c];
+						weight = potentials->originalWeight(matrix.Rows[r], matrix.Columns[c], weight);
+					}
+				}
+			}
+			outputDistanceMatrix(graph, settings, matrix);
+			return;
+		}
+		cout << "Applying contraction hierarchies minimal weight path search..." << endl;
+		ChResult ch_result;
+		chQuery(hierarchy, source, target, workspace, handleCsrAlgorithmEvent, ch_result, &user_context);
+		if (ch_result.ResultCode == AlgoResultCode::Found) {
+			//Path in the hierarchy has shortcuts, it is unpacked to the path in the graph
+			vector<uint32_t> path;
+			unpackChPath(hierarchy, workspace, source, target, ch_result, path);
+			if (potentials) ch_result.PathWeight = potentials->originalWeight(source, target, ch_result.PathWeight);
+			cout << "The path from source to target has been found: " << endl << "\t";
+			for (uint32_t v : path) cout << graph.Names[v] << "; ";
+			cout << "\n\tShortest path weight: " << ch_result.PathWeight << "\n";
+			return;
+		}
+		result = ch_result;
+		break;
+	}
+	case Algorithm::HubLabels: {
+		HubLabels labels;
+		if (!prepareHubLabels(graph, settings, labels)) return;
+		cout << "Applying hub label distance query..." << endl;
+		HubLabelResult hub_result;
+		hubLabelQuery(labels, source, target, hub_result);
+		if (hub_result.ResultCode == AlgoResultCode::Found) {
+			vector<uint32_t> path;
+			hubLabelPath(labels, source, target, hub_result, path);
+			if (potentials) hub_result.PathWeight = potentials->originalWeight(source, target, hub_result.PathWeight);
+			cout << "The path from source to target has been found: " << endl << "\t";
+			for (uint32_t v : path) cout << graph.Names[v] << "; ";
+			cout << "\n\tShortest path weight: " << hub_result.PathWeight << "\n";
+			return;
+		}
+		result = hub_result;
+		break;
+	}
+	case Algorithm::AllPairs: {
+		//With query file only the rows of its sources and the columns of its targets are found
+		vector<uint32_t> sources, targets;
+		if (!settings.QueryFile.empty() && !readMatrixQuery(graph, settings.QueryFile, sources, targets)) return;
+		if (settings.QueryFile.empty() && graph.vertexCount() > APSP_MAX_VERTICES) {
+			cout << "All-pairs search is limited to " << APSP_MAX_VERTICES << " vertices." << endl;
+			return;
+		}
+		if (settings.QueryFile.empty()) cout << "Applying all-pairs minimal weight path search..." << endl;
+		else cout << "Applying many-to-many minimal weight path search: " << sources.size() << " sources, " << targets.size() << " targets..." << endl;
+		ThreadPool pool(settings.Threads);
+		DistanceMatrix matrix;
+		ApspResult apsp_result;
+		auto start = chrono::steady_clock::now();
+		if (settings.QueryFile.empty()) allPairsShortestPaths(graph, pool, settings.Apsp, matrix, apsp_result);
+		else distanceMatrix(graph, pool, sources, targets, matrix, apsp_result);
+		chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+		if (settings.QueryFile.empty()) cout << "Method: " << apspMethodName(apsp_result.Method) << endl;
+		if (settings.Verbose) cout << "\tthreads: " << pool.size() << endl;
+		if (settings.Verbose || settings.BenchmarkQueries > 0) cout << "\ttotal time: " << elapsed.count() << " ms" << endl;
+		if (apsp_result.ResultCode == AlgoResultCode::NegativeLoopFound) {
+			printResultCode(apsp_result.ResultCode);
+			printNegativeCycle(graph, apsp_result.NegativeCycle);
+			return;
+		}
+		outputDistanceMatrix(graph, settings, matrix);
+		return;
+	}
+	case Algorithm::DirectionOptimizingBfs:
+		cout << "Applying direction-optimizing breadth-first search..." << endl;
+		directionOptimizingBfs(graph, source, target, workspace, handleCsrAlgorithmEvent, bfs_result, &user_context);
+		printBfsCounters(bfs_result);
+		result = bfs_result;
+		break;
+	default: return;
+	}
+
+	//Search ran on the reweighted graph: weights in workspace are converted back to the original ones
+	if (potentials && keepsPathWeights(settings.SearchAlgorithm) &&
+			(result.ResultCode == AlgoResultCode::Ok || result.ResultCode == AlgoResultCode::Found)) {
+		restoreForwardWeights(*potentials, source, workspace.Forward);
+		if (isBidirectional(settings.SearchAlgorithm)) {
+			restoreBackwardWeights(*potentials, target, workspace.Backward);
+			fast_dijkstra_result.ConnectingEdgeWeight = potentials->originalWeight(fast_dijkstra_result.ForwardSearchLastVertex,
+					fast_dijkstra_result.BackwardSearchLastVertex, fast_dijkstra_result.ConnectingEdgeWeight);
+		}
+	}
+
+	//Parallel algorithms and Dijkstra searches label all vertices when target is not given
+	if (result.ResultCode == AlgoResultCode::Ok) {
+		printPathsToAllVertices(source, graph, workspace.Forward, settings.CompactPaths);
+		return;
+	}
+	if (result.ResultCode != AlgoResultCode::Found) {
+		printResultCode(result.ResultCode);
+		return;
+	}
+
+	cout << "The path from source to target has been found: " << endl;
+	uint32_t v = isBidirectional(settings.SearchAlgorithm) ? fast_dijkstra_result.ForwardSearchLastVertex : target;
+	stack<uint32_t> path;
+	path.push(v);
+	while (v != source) {
+		v = workspace.Forward.parent(v);
+		path.push(v);
+	}
+
+	cout << "\t";
+	while (!path.empty()) {
+		cout << graph.Names[path.top()] << "; ";
+		path.pop();
+	}
+
+	if (isBidirectional(settings.SearchAlgorithm)) {
+		v = fast_dijkstra_result.BackwardSearchLastVertex;
+		cout << graph.Names[v] << ";";
+		while (v != target) {
+			v = workspace.Backward.parent(v);
+			cout << graph.Names[v] << ";";
+		}
+	}
+
+	cout << "\n\tShortest path weight: ";
+	switch(settings.SearchAlgorithm) {
+	case Algorithm::Dijkstra:
+	case Algorithm::BellmanFord:
+	case Algorithm::Spfa:
+	case Algorithm::ParallelBellmanFord:
+	case Algorithm::DialDijkstra:
+	case Algorithm::DeltaStepping:
+	case Algorithm::AStar:
+	case Algorithm::Alt:
+		cout << workspace.Forward.weight(target);
+		break;
+	case Algorithm::Dijkstra2D:
+	case Algorithm::BreadthFirstSearch:
+	case Algorithm::DepthFirstSearch:
+	case Algorithm::DirectionOptimizingBfs:
+	case Algorithm::ParallelBfs:
+	case Algorithm::BidirectionalBfs:
+		cout << "unknown (used algorithm is not capable to detect path of lowest weight)\n";
+		break;
+	case Algorithm::FastDijkstra:
+	case Algorithm::BidirectionalAlt:
+		cout << workspace.Forward.weight(fast_dijkstra_result.ForwardSearchLastVertex) +
+			workspace.Backward.weight(fast_dijkstra_result.BackwardSearchLastVertex) +
+			fast_dijkstra_result.ConnectingEdgeWeight << "\n";
+		break;
+	default:
+		break;
+	}
+}
+
+const char* queueName(QueueType queue) {
+	switch (queue) {
+	case QueueType::DaryHeap: return "4-ary heap";
+	case QueueType::Pairing: return "pairing heap";
+	case QueueType::Radix: return "radix heap";
+	default: return "binomial heap";
+	}
+}
+
+//Name of the queue used by the algorithm selected in settings, nullptr if it uses no queue
+const char* queueName(const Settings& settings, const QueryWorkspace& workspace, weight_t max_edge_weight) {
+	if (settings.SearchAlgorithm == Algorithm::DialDijkstra) {
+		return max_edge_weight < 0 ? "binary heap" : "Dial's bucket";
+	}
+	if (settings.SearchAlgorithm == Algorithm::DeltaStepping) return "delta-stepping bucket";
+	if (settings.SearchAlgorithm == Algorithm::ParallelBfs) return "frontier";
+	if (settings.SearchAlgorithm == Algorithm::HubLabels || settings.SearchAlgorithm == Algorithm::ParallelBellmanFord) return nullptr;
+	//Radix heap needs monotone integer keys, A* and ALT priorities are not
+	bool informed = settings.SearchAlgorithm == Algorithm::AStar || settings.SearchAlgorithm == Algorithm::Alt ||
+			settings.SearchAlgorithm == Algorithm::BidirectionalAlt;
+	if (informed && workspace.Queue == QueueType::Radix) return queueName(QueueType::DaryHeap);
+	return queueName(workspace.Queue);
+}
+
+//Runs settings.BenchmarkQueries queries between pseudo-random vertices and reports time spent.
+//vertex_count - upper bound of vertex ids, query pairs are drawn from 0..vertex_count-1
+//query(source, target) - runs one query and returns its result code
+//queue_name - name of the priority queue used, nullptr if the algorithm uses no queue
+template <class Query>
+void runBenchmark(uint32_t vertex_count, Settings& settings, const char* queue_name, Query query) {
+	if (vertex_count == 0) return;
+	vector<pair<uint32_t, uint32_t>> queries(settings.BenchmarkQueries);
+	for (auto& q : queries) {
+		q.first = rand() % vertex_count;
+		q.second = rand() % vertex_count;
+	}
+
+	int found = 0;
+	auto start = chrono::steady_clock::now();
+	for (auto& q : queries) {
+		if (query(q.first, q.second) == AlgoResultCode::Found) found++;
 	}
+	chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+
+	cout << "Benchmark: " << AlgorithmNames[settings.SearchAlgorithm] << (settings.UseCsr ? " (CSR)" : "");
+	if (queue_name) cout << ", " << queue_name << (settings.LazyQueue ? " queue, lazy" : " queue, eager") << " insertion";
+	cout << "\n";
+	cout << "\tqueries: " << queries.size() << ", paths found: " << found << "\n";
+	cout << "\ttotal time: " << elapsed.count() << " ms, per query: " << elapsed.count() * 1000 / queries.size() << " us\n";
+}
+
+void benchmarkAlgo(Graph& graph, Settings& settings) {
+	QueryWorkspace workspace;
+	setupWorkspace(workspace, settings, graph);
+	weight_t max_edge_weight = dialMaxEdgeWeight(graph);
+	HeuristicType heuristic = selectHeuristic(settings.Heuristic, is2d(graph));
+	weight_t scale = heuristicScale(heuristic, graph);
+	runBenchmark(graph.idCount(), settings, queueName(settings, workspace, max_edge_weight), [&](vertex_id_t source, vertex_id_t target) {
+		AlgoResult result;
+		BidirectionalDijkstraResult fast_dijkstra_result;
+		BfsResult bfs_result;
+		BellmanFordResult bellman_ford_result;
+		switch (settings.SearchAlgorithm) {
+		case Algorithm::BreadthFirstSearch:
+			bfs(source, target, graph, nullptr, result);
+			break;
+		case Algorithm::DepthFirstSearch:
+			dfs(source, target, graph, nullptr, result);
+			break;
+		case Algorithm::Dijkstra:
+			dijkstra(source, target, graph, workspace, nullptr, result);
+			break;
+		case Algorithm::BellmanFord:
+			bellmanFord(source, target, graph, workspace, nullptr, bellman_ford_result);
+			result = bellman_ford_result;
+			break;
+		case Algorithm::Spfa:
+			spfa(source, target, graph, workspace, nullptr, bellman_ford_result);
+			result = bellman_ford_result;
+			break;
+		case Algorithm::FastDijkstra:
+			bidirectionalDijkstra(source, target, graph, workspace, nullptr, fast_dijkstra_result);
+			result = fast_dijkstra_result;
+			break;
+		case Algorithm::BidirectionalBfs:
+			bidirectionalBfs(source, target, graph, workspace, nullptr, fast_dijkstra_result);
+			result = fast_dijkstra_result;
+			break;
+		case Algorithm::Dijkstra2D:
+			dijkstra2d(source, target, graph, workspace, nullptr, result);
+			break;
+		case Algorithm::DialDijkstra:
+			dialDijkstra(source, target, graph, workspace, max_edge_weight, nullptr, result);
+			break;
+		case Algorithm::AStar:
+			withHeuristic(heuristic, scale, [&](const auto& h) {
+				aStar(source, target, graph, workspace, h, nullptr, result);
+			});
+			break;
+		case Algorithm::DirectionOptimizingBfs:
+			directionOptimizingBfs(source, target, graph, workspace, nullptr, bfs_result);
+			result = bfs_result;
+			break;
+		default:
+			break;
+		}
+		clearContext(graph);
+		return result.ResultCode;
+	});
+}
+
+void benchmarkCsrAlgo(CsrGraph& graph, Settings& settings) {
+	QueryWorkspace workspace;
+	setupWorkspace(workspace, settings, graph);
+	weight_t max_edge_weight = dialMaxEdgeWeight(graph);
+	bool parallel = settings.SearchAlgorithm == Algorithm::DeltaStepping || settings.SearchAlgorithm == Algorithm::ParallelBfs ||
+			settings.SearchAlgorithm == Algorithm::ParallelBellmanFord;
+	ThreadPool pool(parallel ? settings.Threads : 1);
+	HeuristicType heuristic = selectHeuristic(settings.Heuristic, is2d(graph));
+	weight_t scale = heuristicScale(heuristic, graph);
+	LandmarkTable landmarks;
+	if (settings.SearchAlgorithm == Algorithm::Alt || settings.SearchAlgorithm == Algorithm::BidirectionalAlt) {
+		if (!prepareLandmarks(graph, settings, landmarks)) return;
+	}
+	ContractionHierarchy hierarchy;
+	if (settings.SearchAlgorithm == Algorithm::ContractionHierarchies) {
+		if (!prepareHierarchy(graph, settings, hierarchy)) return;
+	}
+	HubLabels labels;
+	if (settings.SearchAlgorithm == Algorithm::HubLabels) {
+		if (!prepareHubLabels(graph, settings, labels)) return;
+	}
+	runBenchmark(graph.vertexCount(), settings, queueName(settings, workspace, max_edge_weight), [&](uint32_t source, uint32_t target) {
+		AlgoResult result;
+		CsrBidirectionalResult fast_dijkstra_result;
+		BfsResult bfs_result;
+		CsrBellmanFordResult bellman_ford_result;
+		ChResult ch_result;
+		HubLabelResult hub_result;
+		switch (settings.SearchAlgorithm) {
+		case Algorithm::BreadthFirstSearch:
+			bfs(graph, source, target, workspace, nullptr, result);
+			break;
+		case Algorithm::DepthFirstSearch:
+			dfs(graph, source, target, workspace, nullptr, result);
+			break;
+		case Algorithm::Dijkstra:
+			dijkstra(graph, source, target, workspace, nullptr, result);
+			break;
+		case Algorithm::BellmanFord:
+			bellmanFord(graph, source, target, workspace, nullptr, bellman_ford_result);
+			result = bellman_ford_result;
+			break;
+		case Algorithm::Spfa:
+			spfa(graph, source, target, workspace, nullptr, bellman_ford_result);
+			result = bellman_ford_result;
+			break;
+		case Algorithm::FastDijkstra:
+			bidirectionalDijkstra(graph, source, target, workspace, nullptr, fast_dijkstra_result);
+			result = fast_dijkstra_result;
+			break;
+		case Algorithm::BidirectionalBfs:
+			bidirectionalBfs(graph, source, target, workspace, nullptr, fast_dijkstra_result);
+			result = fast_dijkstra_result;
+			break;
+		case Algorithm::Dijkstra2D:
+			dijkstra2d(graph, source, target, workspace, nullptr, result);
+			break;
+		case Algorithm::DialDijkstra:
+			dialDijkstra(graph, source, target, workspace, max_edge_weight, nullptr, result);
+			break;
+		case Algorithm::DeltaStepping:
+			deltaStepping(graph, source, target, workspace, pool, settings.Delta, nullptr, result);
+			break;
+		case Algorithm::ParallelBfs:
+			parallelBfs(graph, source, target, workspace, pool, nullptr, result);
+			break;
+		case Algorithm::ParallelBellmanFord:
+			parallelBellmanFord(graph, source, target, workspace, pool, nullptr, bellman_ford_result);
+			result = bellman_ford_result;
+			break;
+		case Algorithm::AStar:
+			withHeuristic(heuristic, scale, [&](const auto& h) {
+				aStar(graph, source, target, workspace, h, nullptr, result);
+			});
+			break;
+		case Algorithm::Alt:
+			altSearch(graph, landmarks, source, target, workspace, nullptr, result);
+			break;
+		case Algorithm::BidirectionalAlt:
+			bidirectionalAlt(graph, landmarks, source, target, workspace, nullptr, fast_dijkstra_result);
+			result = fast_dijkstra_result;
+			break;
+		case Algorithm::ContractionHierarchies:
+			chQuery(hierarchy, source, target, workspace, nullptr, ch_result);
+			result = ch_result;
+			break;
+		case Algorithm::HubLabels:
+			hubLabelQuery(labels, source, target, hub_result);
+			result = hub_result;
+			break;
+		case Algorithm::DirectionOptimizingBfs:
+			directionOptimizingBfs(graph, source, target, workspace, nullptr, bfs_result);
+			result = bfs_result;
+			break;
+		default:
+			break;
+		}
+		return result.ResultCode;
+	});
 }
 
 void printError(int err) {
@@ -278,8 +1232,18 @@ int main(int argc, char **argv) {
 	if (NO_ERROR != (error = settings.parse(argc, argv))) {
 		exit(error);
 	}
+	//Parallel algorithms and algorithms with preprocessing work on CSR graph only
+	if (settings.SearchAlgorithm == Algorithm::DeltaStepping || settings.SearchAlgorithm == Algorithm::ParallelBfs ||
+			settings.SearchAlgorithm == Algorithm::Alt || settings.SearchAlgorithm == Algorithm::BidirectionalAlt ||
+			settings.SearchAlgorithm == Algorithm::ContractionHierarchies || settings.SearchAlgorithm == Algorithm::HubLabels ||
+			settings.SearchAlgorithm == Algorithm::ParallelBellmanFord || settings.SearchAlgorithm == Algorithm::AllPairs ||
+			settings.Reweight) {
+		settings.UseCsr = true;
+	}
 
 	Graph graph;
+	CsrGraph csr_graph;
+	bool csr_loaded = false;
 
 	cout << " GraphCreator [OPTIONS]\n";
 	if (settings.Verbose) settings.print();
@@ -294,7 +1258,15 @@ int main(int argc, char **argv) {
 			}
 		}
 		else if (settings.FilePath.rfind(".json") != string::npos) {
-			int err = loadGraph(graph, settings);
+			//Graph is not needed if it is not going to be saved
+			csr_loaded = settings.UseCsr && !settings.SaveToFile;
+			int err;
+			if (settings.StreamJson) {
+				err = csr_loaded ? streamCsrGraph(csr_graph, settings) : streamGraph(graph, settings);
+			}
+			else {
+				err = csr_loaded ? loadCsrGraph(csr_graph, settings) : loadGraph(graph, settings);
+			}
 			if (err != NO_ERROR) {
 				cerr << "Error: Failed loading graph\n";
 				printError(err);
@@ -310,9 +1282,29 @@ int main(int argc, char **argv) {
 		createGraph(graph, settings);
 	}
 
-	if (settings.Verbose) printGraph(graph);
-
-	applyAlgo(graph, settings);
+	if (settings.UseCsr) {
+		if (!csr_loaded) buildCsrGraph(graph, csr_graph);
+		if (settings.Verbose) printGraph(csr_graph);
+		if (settings.Reweight && isBellmanFordFamily(settings.SearchAlgorithm)) {
+			cout << "Reweighting is not used: Bellman-Ford family searches allow negative edge weights." << endl;
+			settings.Reweight = false;
+		}
+		if (settings.Reweight && settings.SearchAlgorithm == Algorithm::AllPairs) {
+			cout << "Reweighting is not used: all-pairs search reweights the graph itself when it is needed." << endl;
+			settings.Reweight = false;
+		}
+		JohnsonPotentials potentials;
+		//If the graph has a negative loop, there are no minimal weight paths to search for
+		bool ready = !settings.Reweight || prepareReweighting(csr_graph, settings, potentials);
+		//Distance matrix is found by a single run, it has no queries to benchmark and reports its time instead
+		if (ready && settings.BenchmarkQueries > 0 && !isMatrixQuery(settings)) benchmarkCsrAlgo(csr_graph, settings);
+		else if (ready) applyCsrAlgo(csr_graph, settings, settings.Reweight ? &potentials : nullptr);
+	}
+	else {
+		if (settings.Verbose) printGraph(graph);
+		if (settings.BenchmarkQueries > 0) benchmarkAlgo(graph, settings);
+		else applyAlgo(graph, settings);
+	}
 
 	if (settings.SaveToFile) {
 		if (settings.FilePath.rfind(".2d") != string::npos) {
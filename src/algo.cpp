@@ -6,9 +6,9 @@
  */
 
 //#include <iterator>
-//#include <algorithm>
+#include <algorithm>
 #include <iostream>
-#include <boost/heap/binomial_heap.hpp>
+#include <cmath>
 #include <queue>
 #include <stack>
 #include "graph.h"
@@ -105,16 +105,9 @@ void dfs(Vertex *source, Vertex *target, Callback callback, AlgoResult& result,
     result.ResultCode = AlgoResultCode::NotFound;
 }
 
-bool DijkstraVertexComparator::operator()(const PVertex& v1, const PVertex& v2) const {
-	if (static_cast<DijkstraContext*>(v1->Context)->Weight > static_cast<DijkstraContext*>(v2->Context)->Weight )
-		return true;
-	else
-		return false;
-	// return "true" if "p1" is ordered before "p2"
-}
-
-void dijkstra(Vertex* source, Vertex* target, Graph& graph, Callback callback, AlgoResult& result, void* user_context) {
-	if (!source || !target) {
+template <class Queue>
+static void dijkstraSearch(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Queue& queue, Callback callback, AlgoResult& result, void* user_context) {
+	if (!source) {
 		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
 		return;
 	};
@@ -124,44 +117,50 @@ void dijkstra(Vertex* source, Vertex* target, Graph& graph, Callback callback, A
 		return;
 	};
 
-	boost::heap::binomial_heap<PVertex, boost::heap::compare<DijkstraVertexComparator>> queue;
-	DijkstraContext *current_vertex_context;
-	for (const auto& pair : graph) {
-		Vertex *v = pair.second;
-		current_vertex_context = new DijkstraContext();
-		if (v == source) {
-			current_vertex_context->Weight = 0;
+	SearchState& state = workspace.Forward;
+	state.reset(graph.idCount());
+	state.touch(source->Id);
+	state.Weight[source->Id] = 0;
+
+	queue.reset(state.Weight.data(), graph.idCount());
+	if (workspace.Insertion == QueueInsertion::Lazy) {
+		queue.push(source->Id);
+	}
+	else {
+		for (const auto& pair : graph) {
+			state.touch(pair.second->Id);
+			queue.push(pair.second->Id);
 		}
-		v->Context = current_vertex_context;
-		static_cast<DijkstraContext*>(v->Context)->Handle = queue.push(v);
 	}
 
 	Vertex* v;
 	while (!queue.empty()) {
-		v = queue.top();
+		vertex_id_t v_id = queue.top();
 		queue.pop();
-		current_vertex_context = static_cast<DijkstraContext*>(v->Context);
+		v = graph.VerticesById[v_id];
 
 		//Dead end
-		if(current_vertex_context->Weight == INFINITE_WEIGHT) {
+		if(state.Weight[v_id] == INFINITE_WEIGHT) {
 			break;
 		}
 
 		if (callback) callback(AlgoEvent::VertexProcessingStarted, v, user_context);
 		for (const auto &e : *(v->OutcomingEdges)) {
-			DijkstraContext *neightbor_vertex_context = static_cast<DijkstraContext*>(e->ToVertex->Context);
-			if (neightbor_vertex_context->Processed) continue;
+			vertex_id_t neighbor_id = e->ToVertex->Id;
+			state.touch(neighbor_id);
+			if (state.Processed[neighbor_id]) continue;
 			if (callback) callback(AlgoEvent::VertexDiscovered, e->ToVertex, user_context);
 
-			weight_t new_weight = current_vertex_context->Weight + e->Weight;
-			if (neightbor_vertex_context->Weight > new_weight) {
-				neightbor_vertex_context->Weight = new_weight;
-				neightbor_vertex_context->Parent = v;
+			weight_t new_weight = state.Weight[v_id] + e->Weight;
+			weight_t old_weight = state.Weight[neighbor_id];
+			if (old_weight > new_weight) {
+				state.Weight[neighbor_id] = new_weight;
+				state.Parent[neighbor_id] = v_id;
 
-				queue.increase(static_cast<VertexHandle>(neightbor_vertex_context->Handle), e->ToVertex);
+				updateQueue(queue, neighbor_id, old_weight, workspace.Insertion);
 			}
 		}
-		static_cast<DijkstraContext*>(v->Context)->Processed = true;
+		state.Processed[v_id] = true;
 		if (callback) callback(AlgoEvent::VertexProcessingFinished, v, user_context);
 
 		if (v == target) {
@@ -173,10 +172,65 @@ void dijkstra(Vertex* source, Vertex* target, Graph& graph, Callback callback, A
 	};
 
 	if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
-	result.ResultCode = AlgoResultCode::NotFound;
+	//Without target the queue runs out when all reachable vertices are labeled
+	result.ResultCode = target ? AlgoResultCode::NotFound : AlgoResultCode::Ok;
+}
+
+void dijkstra(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback, AlgoResult& result, void* user_context) {
+	withSelectedQueue(workspace, true, [&](auto& queue, auto&) {
+		dijkstraSearch(source, target, graph, workspace, queue, callback, result, user_context);
+	});
+}
+
+weight_t dialMaxEdgeWeight(const Graph& graph) {
+	weight_t max_weight = 0;
+	for (const auto& pair : graph) {
+		for (const auto &e : *(pair.second->OutcomingEdges)) {
+			if (e->Weight < 0 || e->Weight > DIAL_MAX_EDGE_WEIGHT || e->Weight != floor(e->Weight)) return -1;
+			if (e->Weight > max_weight) max_weight = e->Weight;
+		}
+	}
+	return max_weight;
+}
+
+void dialDijkstra(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, weight_t max_edge_weight, Callback callback, AlgoResult& result, void* user_context) {
+	if (max_edge_weight < 0) {
+		dijkstraSearch(source, target, graph, workspace, workspace.Forward.BinaryHeap, callback, result, user_context);
+		return;
+	}
+	workspace.Forward.Dial.setMaxWeight(static_cast<uint32_t>(max_edge_weight));
+	dijkstraSearch(source, target, graph, workspace, workspace.Forward.Dial, callback, result, user_context);
 }
 
-void bellmanFord(Vertex* source, Vertex* target, Graph& graph, Callback callback, AlgoResult& result, void* user_context) {
+//Finds a cycle in the graph of parents of a Bellman-Ford family search. Such a cycle always has negative weight.
+//Walks go up the parents from every vertex and stop at vertices visited before, so every vertex is visited once.
+//cycle - vertices of the cycle in path order
+//Returns true if a cycle is found
+static bool findParentCycle(const SearchState& state, Graph& graph, std::vector<Vertex*>& cycle) {
+	std::vector<vertex_id_t> walk(graph.idCount(), NO_VERTEX_ID);   //Start vertex of the walk that visited vertex
+	for (const auto& pair : graph) {
+		vertex_id_t start = pair.second->Id;
+		vertex_id_t v = start;
+		while (v != NO_VERTEX_ID && walk[v] == NO_VERTEX_ID) {
+			walk[v] = start;
+			v = state.parent(v);
+		}
+		if (v != NO_VERTEX_ID && walk[v] == start) {
+			//The walk came back to v, so v is on the cycle
+			cycle.clear();
+			vertex_id_t u = v;
+			do {
+				cycle.push_back(graph.VerticesById[u]);
+				u = state.parent(u);
+			} while (u != v);
+			std::reverse(cycle.begin(), cycle.end());
+			return true;
+		}
+	}
+	return false;
+}
+
+void bellmanFord(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback, BellmanFordResult& result, void* user_context) {
 	if (!source || !target) {
 		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
 		return;
@@ -187,59 +241,166 @@ void bellmanFord(Vertex* source, Vertex* target, Graph& graph, Callback callback
 		return;
 	};
 
-	DijkstraContext *current_vertex_context;
-	for (const auto& pair1 : graph) {
-		Vertex *v = pair1.second;
-		current_vertex_context = new DijkstraContext();
-		if (v == source) {
-			current_vertex_context->Weight = 0;
-		}
-		v->Context = current_vertex_context;
+	SearchState& state = workspace.Forward;
+	state.reset(graph.idCount());
+	for (const auto& pair : graph) {
+		state.touch(pair.second->Id);
 	}
+	state.Weight[source->Id] = 0;
+	result.NegativeCycle.clear();
 
-	//n+1 times as last time is for negative loop check
+	//n+1 times as last time is for negative loop check. If a pass changes nothing, weights are final and the rest are skipped.
 	for (std::vector<Vertex*>::size_type i = 0; i <= graph.size(); i++) {
+		Vertex *changed_vertex = nullptr;
 		for (const auto& pair2 : graph) {
 			Vertex *vertex = pair2.second;
-			current_vertex_context = static_cast<DijkstraContext*>(vertex->Context);
 			for (const auto &e : *(vertex->OutcomingEdges)) {
-				DijkstraContext *neighbor_vertex_context = static_cast<DijkstraContext*>(e->ToVertex->Context);
-				weight_t new_weight = current_vertex_context->Weight + e->Weight;
-				if (neighbor_vertex_context->Weight > new_weight) {
-					neighbor_vertex_context->Weight = new_weight;
-					neighbor_vertex_context->Parent = vertex;
-					if (i == graph.size()) {
-						if (callback) callback(AlgoEvent::NegativeLoopDetected,
-								vertex, user_context);
-						if (callback) callback(AlgoEvent::AlgorithmFinished,
-								nullptr, user_context);
-						result.ResultCode = AlgoResultCode::NegativeLoopFound;
-						return;
-					}
+				vertex_id_t neighbor_id = e->ToVertex->Id;
+				weight_t new_weight = state.Weight[vertex->Id] + e->Weight;
+				if (state.Weight[neighbor_id] > new_weight) {
+					state.Weight[neighbor_id] = new_weight;
+					state.Parent[neighbor_id] = vertex->Id;
+					changed_vertex = vertex;
 				}
 			}
 		}
+		if (!changed_vertex) break;
+		//Parents form a cycle only if there is a negative loop: the check after every pass finds it long before pass n+1
+		if (findParentCycle(state, graph, result.NegativeCycle) || i == graph.size()) {
+			Vertex *vertex = result.NegativeCycle.empty() ? changed_vertex : result.NegativeCycle.front();
+			if (callback) callback(AlgoEvent::NegativeLoopDetected,
+					vertex, user_context);
+			if (callback) callback(AlgoEvent::AlgorithmFinished,
+					nullptr, user_context);
+			result.ResultCode = AlgoResultCode::NegativeLoopFound;
+			return;
+		}
 	}
 
 	if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
-	result.ResultCode = (static_cast<DijkstraContext*>(target->Context)->Weight < INFINITE_WEIGHT) ?
+	result.ResultCode = (workspace.Forward.Weight[target->Id] < INFINITE_WEIGHT) ?
 			AlgoResultCode::Found :
 			AlgoResultCode::NotFound;
 }
 
-bool FastDijkstraForwardComparator::operator()(const PVertex& v1, const PVertex& v2) const {
-	return (static_cast<BidirectionalDijkstraContext*>(v1->Context)->WeightInForwardSearch >
-		static_cast<BidirectionalDijkstraContext*>(v2->Context)->WeightInForwardSearch );
-	// return "true" if "p1" is ordered before "p2"
+//Queue-based Bellman-Ford with subtree disassembly (Tarjan). Vertices with improved path weight are kept in a FIFO queue.
+//Tree of parents is kept as a list of vertices in preorder with their depths. When weight of v improves, the subtree of v
+//is taken out of the tree: weights of its vertices are stale, so they are not scanned until they improve too.
+//If vertex u that improves weight of v is in the subtree of v, edge u->v closes a negative loop.
+//source - source vertex. If it is nullptr, all vertices start with weight 0 (as if there was a vertex with zero weight
+//         edges to all of them), so any negative loop of the graph is found.
+//state - resulting weights and parents
+//cycle - vertices of the negative loop in path order, empty if there is no loop
+static void spfaSearch(Vertex* source, Graph& graph, SearchState& state, std::vector<Vertex*>& cycle) {
+	vertex_id_t id_count = graph.idCount();
+	state.reset(id_count);
+	for (const auto& pair : graph) {
+		state.touch(pair.second->Id);
+	}
+	cycle.clear();
+
+	//Preorder list is circular, root is an extra entry id_count: parent of source or of all vertices.
+	vertex_id_t root = id_count;
+	std::vector<vertex_id_t> next(id_count + 1, root), prev(id_count + 1, root), depth(id_count + 1, 0);
+	std::vector<bool> in_tree(id_count + 1, false);
+	//Puts v to the tree right after parent, i.e. as its first child
+	auto attach = [&](vertex_id_t v, vertex_id_t parent) {
+		next[v] = next[parent];
+		prev[v] = parent;
+		prev[next[parent]] = v;
+		next[parent] = v;
+		depth[v] = depth[parent] + 1;
+		in_tree[v] = true;
+	};
+	//FIFO of vertices with improved path weight. Processed marks vertices in the queue, so a vertex is there at most once
+	//and graph.size() slots of the circular buffer are enough.
+	std::vector<Vertex*> queue(graph.size());
+	size_t head = 0, count = 0;
+	auto push = [&](Vertex* v) {
+		queue[(head + count) % queue.size()] = v;
+		count++;
+		state.Processed[v->Id] = true;
+	};
+
+	in_tree[root] = true;
+	for (const auto& pair : graph) {
+		Vertex *vertex = pair.second;
+		if (source && vertex != source) continue;
+		state.Weight[vertex->Id] = 0;
+		attach(vertex->Id, root);
+		push(vertex);
+	}
+
+	while (count > 0) {
+		Vertex *vertex = queue[head];
+		head = (head + 1) % queue.size();
+		count--;
+		vertex_id_t u = vertex->Id;
+		state.Processed[u] = false;
+		if (!in_tree[u]) continue;
+		for (const auto &e : *(vertex->OutcomingEdges)) {
+			vertex_id_t v = e->ToVertex->Id;
+			weight_t new_weight = state.Weight[u] + e->Weight;
+			if (!(state.Weight[v] > new_weight)) continue;
+			if (v == u) {
+				cycle.push_back(vertex);
+				return;
+			}
+			if (in_tree[v]) {
+				vertex_id_t x = next[v];
+				while (depth[x] > depth[v]) {
+					if (x == u) {
+						for (vertex_id_t y = u; y != v; y = state.Parent[y]) cycle.push_back(graph.VerticesById[y]);
+						cycle.push_back(e->ToVertex);
+						std::reverse(cycle.begin(), cycle.end());
+						return;
+					}
+					in_tree[x] = false;
+					x = next[x];
+				}
+				next[prev[v]] = x;
+				prev[x] = prev[v];
+			}
+			state.Weight[v] = new_weight;
+			state.Parent[v] = u;
+			attach(v, u);
+			if (!state.Processed[v]) push(e->ToVertex);
+		}
+	}
+}
+
+void spfa(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback, BellmanFordResult& result, void* user_context) {
+	if (!source || !target) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	};
+
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	};
+
+	spfaSearch(source, graph, workspace.Forward, result.NegativeCycle);
+	if (!result.NegativeCycle.empty()) {
+		if (callback) callback(AlgoEvent::NegativeLoopDetected, result.NegativeCycle.front(), user_context);
+		if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
+		result.ResultCode = AlgoResultCode::NegativeLoopFound;
+		return;
+	}
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
+	result.ResultCode = (workspace.Forward.Weight[target->Id] < INFINITE_WEIGHT) ?
+			AlgoResultCode::Found :
+			AlgoResultCode::NotFound;
 }
 
-bool FastDijkstraBackwardComparator::operator()(const PVertex& v1, const PVertex& v2) const {
-	return (static_cast<BidirectionalDijkstraContext*>(v1->Context)->WeightInBackwardSearch >
-		static_cast<BidirectionalDijkstraContext*>(v2->Context)->WeightInBackwardSearch );
-	// return "true" if "p1" is ordered before "p2"
+bool findNegativeCycle(Vertex* source, Graph& graph, QueryWorkspace& workspace, std::vector<Vertex*>& cycle) {
+	spfaSearch(source, graph, workspace.Forward, cycle);
+	return !cycle.empty();
 }
 
-void bidirectionalDijkstra(Vertex* source, Vertex* target, Graph& graph, Callback callback, BidirectionalDijkstraResult& result, void* user_context) {
+template <class Queue>
+static void bidirectionalDijkstraSearch(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Queue& forward_queue, Queue& backward_queue, Callback callback, BidirectionalDijkstraResult& result, void* user_context) {
 	if (!source || !target) {
 		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
 		return;
@@ -250,47 +411,46 @@ void bidirectionalDijkstra(Vertex* source, Vertex* target, Graph& graph, Callbac
 		return;
 	};
 
-	boost::heap::binomial_heap<PVertex, boost::heap::compare<FastDijkstraForwardComparator>> forward_queue;
-	boost::heap::binomial_heap<PVertex, boost::heap::compare<FastDijkstraBackwardComparator>> backward_queue;
-	BidirectionalDijkstraContext *init_context;
+	SearchState& forward = workspace.Forward;
+	SearchState& backward = workspace.Backward;
+	forward.reset(graph.idCount());
+	backward.reset(graph.idCount());
+	forward.touch(source->Id);
+	backward.touch(target->Id);
+	forward.Weight[source->Id] = 0;
+	backward.Weight[target->Id] = 0;
+
+	forward_queue.reset(forward.Weight.data(), graph.idCount());
+	backward_queue.reset(backward.Weight.data(), graph.idCount());
 	result.ResultCode = AlgoResultCode::NotFound;
-	//initialize all vertices' contexts
-	for (const auto& pair : graph) {
-		Vertex* v = pair.second;
-		init_context = new BidirectionalDijkstraContext();
-		v->Context = init_context;
-		if (v == source) {
-			init_context->WeightInForwardSearch = 0;
-		}
-		if (v == target) {
-			init_context->WeightInBackwardSearch = 0;
+	if (workspace.Insertion == QueueInsertion::Lazy) {
+		forward_queue.push(source->Id);
+		backward_queue.push(target->Id);
+	}
+	else {
+		//put all vertices to both queues
+		for (const auto& pair : graph) {
+			vertex_id_t v_id = pair.second->Id;
+			forward.touch(v_id);
+			backward.touch(v_id);
+			forward_queue.push(v_id);
+			backward_queue.push(v_id);
 		}
-		init_context->HandleInForwardSearch = forward_queue.push(v);
-		init_context->HandleInBackwardSearch = backward_queue.push(v);
 	}
 	
 	weight_t shortest_path_weight = INFINITE_WEIGHT, new_path_weight;
-	Vertex *current_forward_search_vertex, *current_backward_search_vertex, *neighbor;
+	vertex_id_t current_forward_search_vertex, current_backward_search_vertex, neighbor;
 	Vertex *forward_shortest_path_vertex = nullptr, *backward_shortest_path_vertex = nullptr;
-	BidirectionalDijkstraContext *neighbor_context, *forward_search_current_context, *backward_search_current_context;;
 	weight_t shortest_path_bridge_weight = INFINITE_WEIGHT;
 
 	while (!forward_queue.empty() && !backward_queue.empty()) {
 		current_forward_search_vertex = forward_queue.top();
 		current_backward_search_vertex = backward_queue.top();
-		forward_search_current_context = static_cast<BidirectionalDijkstraContext*>(current_forward_search_vertex->Context);
-		backward_search_current_context = static_cast<BidirectionalDijkstraContext*>(current_backward_search_vertex->Context);
 
-		//Dead end check
-		if (forward_search_current_context->WeightInForwardSearch == INFINITE_WEIGHT) {
-			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
-			result.ResultCode = AlgoResultCode::NotFound;
-			return;
-		}
-		
-		double best_forward_search = forward_search_current_context->WeightInForwardSearch;
-		double best_backward_search = backward_search_current_context->WeightInBackwardSearch;
-		//If path found and there no candidates to be shortest
+		double best_forward_search = forward.Weight[current_forward_search_vertex];
+		double best_backward_search = backward.Weight[current_backward_search_vertex];
+		//If path found and there no candidates to be shortest. It is checked before dead end: the path found is the shortest
+		//one if a search has nothing more to process.
 		if (shortest_path_weight < INFINITE_WEIGHT && shortest_path_weight < best_forward_search + best_backward_search)
 		{
 			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
@@ -300,52 +460,53 @@ void bidirectionalDijkstra(Vertex* source, Vertex* target, Graph& graph, Callbac
 			result.ResultCode = AlgoResultCode::Found;
 			return;
 		}
+
+		//Dead end check
+		if (forward.Weight[current_forward_search_vertex] == INFINITE_WEIGHT) {
+			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
+			result.ResultCode = AlgoResultCode::NotFound;
+			return;
+		}
 		
-		//process current vertex in forward search
+		//process current vertex in forward search. It is taken from the queue first: a neighbor reached by zero weight edge
+		//gets the same key and may become the top.
 		if (!forward_queue.empty()) {
-			forward_search_current_context = static_cast<BidirectionalDijkstraContext*>(current_forward_search_vertex->Context);
-			if (callback) callback(AlgoEvent::VertexProcessingStarted, current_forward_search_vertex, user_context);
+			forward_queue.pop();
+			Vertex *current_vertex = graph.VerticesById[current_forward_search_vertex];
+			if (callback) callback(AlgoEvent::VertexProcessingStarted, current_vertex, user_context);
 		
 			//process all outgoing edges from current forward search vertex
-			for (const auto &fe : *(current_forward_search_vertex->OutcomingEdges)) {
-				neighbor = fe->ToVertex;
-				neighbor_context = static_cast<BidirectionalDijkstraContext*>(neighbor->Context);
+			for (const auto &fe : *(current_vertex->OutcomingEdges)) {
+				neighbor = fe->ToVertex->Id;
+				forward.touch(neighbor);
 				//if this vertex is already processed no need to process it again
-				if (neighbor_context->ProcessedByForwardSearch) continue;
-				if (callback) callback(AlgoEvent::VertexDiscovered, neighbor, user_context);
+				if (forward.Processed[neighbor]) continue;
+				if (callback) callback(AlgoEvent::VertexDiscovered, fe->ToVertex, user_context);
 				
 				//release edge - update neighbor vertex weight and parent
-				if (neighbor_context->WeightInForwardSearch > forward_search_current_context->WeightInForwardSearch + fe->Weight) {
-					neighbor_context->WeightInForwardSearch = forward_search_current_context->WeightInForwardSearch + fe->Weight;
-					neighbor_context->ParentInForwardSearch = current_forward_search_vertex;
+				weight_t old_weight = forward.Weight[neighbor];
+				if (old_weight > forward.Weight[current_forward_search_vertex] + fe->Weight) {
+					forward.Weight[neighbor] = forward.Weight[current_forward_search_vertex] + fe->Weight;
+					forward.Parent[neighbor] = current_forward_search_vertex;
 
-					forward_queue.increase(static_cast<ForwardSearchVertexHandle>(neighbor_context->HandleInForwardSearch), neighbor);
+					updateQueue(forward_queue, neighbor, old_weight, workspace.Insertion);
 				}
 
 				//if neighbor vertex is already processed by backward search check weather we have new shortest path!
-				if (neighbor_context->ProcessedByBackwardSearch) {
-					new_path_weight = neighbor_context->WeightInBackwardSearch + fe->Weight + forward_search_current_context->WeightInForwardSearch;
+				if (backward.processed(neighbor)) {
+					new_path_weight = backward.Weight[neighbor] + fe->Weight + forward.Weight[current_forward_search_vertex];
 					if (new_path_weight < shortest_path_weight) {
 						shortest_path_weight = new_path_weight;
-						forward_shortest_path_vertex = current_forward_search_vertex;
-						backward_shortest_path_vertex = neighbor;
+						forward_shortest_path_vertex = current_vertex;
+						backward_shortest_path_vertex = fe->ToVertex;
 						shortest_path_bridge_weight = fe->Weight;
 					}
 				}
 			}
-			forward_search_current_context->ProcessedByForwardSearch = true;
-			if (callback) callback(AlgoEvent::VertexProcessingFinished, current_forward_search_vertex, user_context);
-
-			forward_queue.pop();
+			forward.Processed[current_forward_search_vertex] = true;
+			if (callback) callback(AlgoEvent::VertexProcessingFinished, current_vertex, user_context);
 		};
 
-		//Dead end found
-		if (backward_search_current_context->WeightInBackwardSearch == INFINITE_WEIGHT) {
-			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
-			result.ResultCode = AlgoResultCode::NotFound;
-			return;
-		}
-
 		if (shortest_path_weight < INFINITE_WEIGHT && shortest_path_weight < best_forward_search + best_backward_search)
 		{
 			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
@@ -356,61 +517,174 @@ void bidirectionalDijkstra(Vertex* source, Vertex* target, Graph& graph, Callbac
 			return;
 		}
 
-		//process current vertex in forward search
+		//Dead end found
+		if (backward.Weight[current_backward_search_vertex] == INFINITE_WEIGHT) {
+			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
+			result.ResultCode = AlgoResultCode::NotFound;
+			return;
+		}
+
+		//process current vertex in backward search
 		if (!backward_queue.empty()) {
-			backward_search_current_context = static_cast<BidirectionalDijkstraContext*>(current_backward_search_vertex->Context);
-			if (callback) callback(AlgoEvent::VertexProcessingStarted, current_backward_search_vertex, user_context);
+			backward_queue.pop();
+			Vertex *current_vertex = graph.VerticesById[current_backward_search_vertex];
+			if (callback) callback(AlgoEvent::VertexProcessingStarted, current_vertex, user_context);
 		
 			//process all incoming edges to current backward search vertex
-			for (const auto &be : *(current_backward_search_vertex->IncomingEdges)) {
-				neighbor = be->FromVertex;
-				neighbor_context = static_cast<BidirectionalDijkstraContext*>(neighbor->Context);
+			for (const auto &be : *(current_vertex->IncomingEdges)) {
+				neighbor = be->FromVertex->Id;
+				backward.touch(neighbor);
 				//if this vertex is already processed no need to process it again
-				if (neighbor_context->ProcessedByBackwardSearch) continue;
-				if (callback) callback(AlgoEvent::VertexDiscovered, neighbor, user_context);
+				if (backward.Processed[neighbor]) continue;
+				if (callback) callback(AlgoEvent::VertexDiscovered, be->FromVertex, user_context);
 				
 				//release edge - update neighbor vertex weight and parent
-				if (neighbor_context->WeightInBackwardSearch > backward_search_current_context->WeightInBackwardSearch + be->Weight) {
-					neighbor_context->WeightInBackwardSearch = backward_search_current_context->WeightInBackwardSearch + be->Weight;
-					neighbor_context->ParentInBackwardSearch = current_backward_search_vertex;
+				weight_t old_weight = backward.Weight[neighbor];
+				if (old_weight > backward.Weight[current_backward_search_vertex] + be->Weight) {
+					backward.Weight[neighbor] = backward.Weight[current_backward_search_vertex] + be->Weight;
+					backward.Parent[neighbor] = current_backward_search_vertex;
 
-					backward_queue.increase(static_cast<BackwardSearchVertexHandle>(neighbor_context->HandleInBackwardSearch), neighbor);
+					updateQueue(backward_queue, neighbor, old_weight, workspace.Insertion);
 				}
 
 				//if neighbor vertex is already processed by forward search check weather we have new shortest path!
-				if (neighbor_context->ProcessedByForwardSearch) {
-					new_path_weight = neighbor_context->WeightInForwardSearch + be->Weight + backward_search_current_context->WeightInBackwardSearch;
+				if (forward.processed(neighbor)) {
+					new_path_weight = forward.Weight[neighbor] + be->Weight + backward.Weight[current_backward_search_vertex];
 					if (new_path_weight < shortest_path_weight) {
 						shortest_path_weight = new_path_weight;
-						forward_shortest_path_vertex = neighbor;
-						backward_shortest_path_vertex = current_backward_search_vertex;
+						forward_shortest_path_vertex = be->FromVertex;
+						backward_shortest_path_vertex = current_vertex;
 						shortest_path_bridge_weight = be->Weight;
 					}
 				}
 			}
-			backward_search_current_context->ProcessedByBackwardSearch = true;
-			if (callback) callback(AlgoEvent::VertexProcessingFinished, current_backward_search_vertex, user_context);
-
-			backward_queue.pop();
+			backward.Processed[current_backward_search_vertex] = true;
+			if (callback) callback(AlgoEvent::VertexProcessingFinished, current_vertex, user_context);
 		};
 	}
+	//In lazy insertion mode a queue runs out when everything reachable is explored, the path may be already found
+	if (shortest_path_weight < INFINITE_WEIGHT) {
+		result.ForwardSearchLastVertex = forward_shortest_path_vertex;
+		result.BackwardSearchLastVertex = backward_shortest_path_vertex;
+		result.ConnectingEdgeWeight = shortest_path_bridge_weight;
+		result.ResultCode = AlgoResultCode::Found;
+	}
 	if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
 };
 
-void clearContext (Algorithm algo, Graph& graph) {
-	for (auto &pair : graph) {
-		Vertex *vertex = pair.second;
-		switch (algo) {
-		case Algorithm::Dijkstra:
-		case Algorithm::BellmanFord:
-		case Algorithm::Dijkstra2D:
-			delete static_cast<DijkstraContext*>(vertex->Context);
-			break;
-		case Algorithm::FastDijkstra:
-			delete static_cast<BidirectionalDijkstraContext*>(vertex->Context);
-			break;
-		default: break;
+void bidirectionalDijkstra(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback, BidirectionalDijkstraResult& result, void* user_context) {
+	withSelectedQueue(workspace, true, [&](auto& forward_queue, auto& backward_queue) {
+		bidirectionalDijkstraSearch(source, target, graph, workspace, forward_queue, backward_queue, callback, result, user_context);
+	});
+}
+
+void bidirectionalBfs(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback, BidirectionalDijkstraResult& result, void* user_context) {
+	if (!source || !target) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	};
+
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	};
+
+	SearchState& forward = workspace.Forward;
+	SearchState& backward = workspace.Backward;
+	forward.reset(graph.idCount());
+	backward.reset(graph.idCount());
+	forward.touch(source->Id);
+	backward.touch(target->Id);
+	forward.Weight[source->Id] = 0;
+	backward.Weight[target->Id] = 0;
+
+	vector<Vertex*> forward_frontier(1, source), backward_frontier(1, target), next;
+	weight_t shortest_path_length = INFINITE_WEIGHT;
+	result.ResultCode = AlgoResultCode::NotFound;
+
+	while (!forward_frontier.empty() && !backward_frontier.empty()) {
+		//expand a whole level of the smaller frontier
+		bool is_forward = forward_frontier.size() <= backward_frontier.size();
+		SearchState& own = is_forward ? forward : backward;
+		SearchState& other = is_forward ? backward : forward;
+		vector<Vertex*>& frontier = is_forward ? forward_frontier : backward_frontier;
+		next.clear();
+		for (Vertex* v : frontier) {
+			if (callback) callback(AlgoEvent::VertexProcessingStarted, v, user_context);
+			for (const auto &e : *(is_forward ? v->OutcomingEdges : v->IncomingEdges)) {
+				Vertex* neighbor = is_forward ? e->ToVertex : e->FromVertex;
+				//the searches met: path goes through edge e
+				if (other.touched(neighbor->Id) && own.Weight[v->Id] + 1 + other.Weight[neighbor->Id] < shortest_path_length) {
+					shortest_path_length = own.Weight[v->Id] + 1 + other.Weight[neighbor->Id];
+					result.ForwardSearchLastVertex = is_forward ? v : neighbor;
+					result.BackwardSearchLastVertex = is_forward ? neighbor : v;
+					result.ConnectingEdgeWeight = e->Weight;
+				}
+				if (own.touched(neighbor->Id)) continue;
+				own.touch(neighbor->Id);
+				own.Weight[neighbor->Id] = own.Weight[v->Id] + 1;
+				own.Parent[neighbor->Id] = v->Id;
+				next.push_back(neighbor);
+				if (callback) callback(AlgoEvent::VertexDiscovered, neighbor, user_context);
+			}
+			if (callback) callback(AlgoEvent::VertexProcessingFinished, v, user_context);
 		}
-		vertex->Context = nullptr;
+		frontier.swap(next);
+
+		//every path not seen yet is longer than the ones found at this level
+		if (shortest_path_length < INFINITE_WEIGHT) {
+			if (callback) callback(AlgoEvent::TargetFound, target, user_context);
+			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
+			result.ResultCode = AlgoResultCode::Found;
+			return;
+		}
+	}
+	if (callback) callback(AlgoEvent::TargetNotFound, nullptr, user_context);
+	if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
+}
+
+void bfs(vertex_id_t source, vertex_id_t target, const Graph& graph, Callback callback, AlgoResult& result, void* user_context) {
+	bfs(findVertex(source, graph), findVertex(target, graph), callback, result, user_context);
+}
+
+void dfs(vertex_id_t source, vertex_id_t target, const Graph& graph, Callback callback, AlgoResult& result, void* user_context) {
+	dfs(findVertex(source, graph), findVertex(target, graph), callback, result, user_context);
+}
+
+void dijkstra(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback, AlgoResult& result, void* user_context) {
+	if (target != NO_VERTEX_ID && !findVertex(target, graph)) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
 	}
+	dijkstra(findVertex(source, graph), findVertex(target, graph), graph, workspace, callback, result, user_context);
+}
+
+void bidirectionalDijkstra(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback, BidirectionalDijkstraResult& result, void* user_context) {
+	bidirectionalDijkstra(findVertex(source, graph), findVertex(target, graph), graph, workspace, callback, result, user_context);
 }
+
+void bidirectionalBfs(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback, BidirectionalDijkstraResult& result, void* user_context) {
+	bidirectionalBfs(findVertex(source, graph), findVertex(target, graph), graph, workspace, callback, result, user_context);
+}
+
+void bellmanFord(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback, BellmanFordResult& result, void* user_context) {
+	bellmanFord(findVertex(source, graph), findVertex(target, graph), graph, workspace, callback, result, user_context);
+}
+
+void spfa(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback, BellmanFordResult& result, void* user_context) {
+	spfa(findVertex(source, graph), findVertex(target, graph), graph, workspace, callback, result, user_context);
+}
+
+void dialDijkstra(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, weight_t max_edge_weight, Callback callback, AlgoResult& result, void* user_context) {
+	if (target != NO_VERTEX_ID && !findVertex(target, graph)) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	dialDijkstra(findVertex(source, graph), findVertex(target, graph), graph, workspace, max_edge_weight, callback, result, user_context);
+}
+
+void clearContext (Graph& graph) {
+	for (auto &pair : graph) {
+		pair.second->Context = nullptr;
+	}
+}
\ No newline at end of file
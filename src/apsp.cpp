@@ -0,0 +1,298 @@
+/*
+ * apsp.cpp
+ *
+ *  All-pairs minimal path weights: blocked Floyd-Warshall and repeated Dijkstra searches.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include "apsp.h"
+#include "johnson.h"
+#include "error.h"
+
+//Side of a square tile of blocked Floyd-Warshall: three tiles of weights (96 KB) stay in L2 cache while a tile is updated
+static constexpr uint32_t FLOYD_WARSHALL_TILE = 64;
+
+//Updates rows i_begin..i_end-1, columns j_begin..j_end-1 of n x n matrix d with paths through vertices k_begin..k_end-1:
+//d[i][j] = min(d[i][j], d[i][k] + d[k][j])
+static void updateTile(weight_t* d, size_t n, uint32_t i_begin, uint32_t i_end, uint32_t j_begin, uint32_t j_end,
+		uint32_t k_begin, uint32_t k_end) {
+	//Part of row k is copied: the copy does not alias the updated row and full tiles have constant width,
+	//so the inner loop is vectorized into packed min and add instructions
+	weight_t through[FLOYD_WARSHALL_TILE];
+	uint32_t width = j_end - j_begin;
+	for (uint32_t k = k_begin; k < k_end; k++) {
+		std::copy(d + k * n + j_begin, d + k * n + j_end, through);
+		for (uint32_t i = i_begin; i < i_end; i++) {
+			weight_t to_k = d[i * n + k];
+			if (to_k >= INFINITE_WEIGHT) continue;
+			weight_t* row = d + i * n + j_begin;
+			if (width == FLOYD_WARSHALL_TILE) {
+				for (uint32_t j = 0; j < FLOYD_WARSHALL_TILE; j++) row[j] = std::min(row[j], to_k + through[j]);
+			}
+			else {
+				for (uint32_t j = 0; j < width; j++) row[j] = std::min(row[j], to_k + through[j]);
+			}
+		}
+	}
+}
+
+static void floydWarshall(const CsrGraph& graph, ThreadPool& pool, std::vector<weight_t>& d) {
+	uint32_t n = graph.vertexCount();
+	pool.parallelFor(n, [&](size_t begin, size_t end, unsigned) {
+		for (size_t v = begin; v < end; v++) {
+			weight_t* row = d.data() + v * n;
+			std::fill(row, row + n, INFINITE_WEIGHT);
+			row[v] = 0;
+			for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+				row[graph.Targets[j]] = std::min(row[graph.Targets[j]], graph.Weights[j]);
+			}
+		}
+	}, 64);
+
+	uint32_t tiles = (n + FLOYD_WARSHALL_TILE - 1) / FLOYD_WARSHALL_TILE;
+	auto first = [](uint32_t tile) { return tile * FLOYD_WARSHALL_TILE; };
+	auto last = [n](uint32_t tile) { return std::min(n, (tile + 1) * FLOYD_WARSHALL_TILE); };
+	for (uint32_t k = 0; k < tiles; k++) {
+		updateTile(d.data(), n, first(k), last(k), first(k), last(k), first(k), last(k));
+		//Tiles of row k (even items) and column k (odd items) depend on the diagonal tile only
+		pool.parallelFor(2 * size_t(tiles), [&](size_t begin, size_t end, unsigned) {
+			for (size_t item = begin; item < end; item++) {
+				uint32_t t = static_cast<uint32_t>(item / 2);
+				if (t == k) continue;
+				if (item % 2 == 0) updateTile(d.data(), n, first(k), last(k), first(t), last(t), first(k), last(k));
+				else updateTile(d.data(), n, first(t), last(t), first(k), last(k), first(k), last(k));
+			}
+		}, 1);
+		//Other tiles depend on tiles of row k and column k only
+		pool.parallelFor(size_t(tiles) * tiles, [&](size_t begin, size_t end, unsigned) {
+			for (size_t item = begin; item < end; item++) {
+				uint32_t i = static_cast<uint32_t>(item / tiles), j = static_cast<uint32_t>(item % tiles);
+				if (i == k || j == k) continue;
+				updateTile(d.data(), n, first(i), last(i), first(j), last(j), first(k), last(k));
+			}
+		}, 1);
+	}
+}
+
+//Dijkstra search from every row vertex of the matrix: row r gets weights of paths from Rows[r] to column vertices.
+//A search stops when all column vertices are settled. Edge weights must be non-negative.
+static void dijkstraRows(const CsrGraph& graph, ThreadPool& pool, DistanceMatrix& matrix) {
+	uint32_t n = graph.vertexCount();
+	std::vector<char> is_column(n, false);
+	uint32_t column_vertices = 0;   //Columns may repeat a vertex
+	for (uint32_t column : matrix.Columns) {
+		if (!is_column[column]) column_vertices++;
+		is_column[column] = true;
+	}
+	std::vector<SearchState> states(pool.size());   //State of each thread is reused by all its searches
+	pool.parallelFor(matrix.rowCount(), [&](size_t begin, size_t end, unsigned thread) {
+		SearchState& state = states[thread];
+		QuaternaryHeapQueue& queue = state.DaryHeap;
+		for (size_t r = begin; r < end; r++) {
+			uint32_t source = matrix.Rows[r];
+			state.reset(n);
+			state.touch(source);
+			state.Weight[source] = 0;
+			queue.reset(state.Weight.data(), n);
+			queue.push(source);
+			uint32_t columns_left = column_vertices;
+			while (!queue.empty() && columns_left > 0) {
+				uint32_t v = queue.top();
+				queue.pop();
+				state.Processed[v] = true;
+				if (is_column[v]) columns_left--;
+				for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+					uint32_t to = graph.Targets[j];
+					state.touch(to);
+					if (state.Processed[to]) continue;
+					weight_t old_weight = state.Weight[to];
+					if (old_weight > state.Weight[v] + graph.Weights[j]) {
+						state.Weight[to] = state.Weight[v] + graph.Weights[j];
+						updateQueue(queue, to, old_weight, QueueInsertion::Lazy);
+					}
+				}
+			}
+			weight_t* row = matrix.Weights.data() + r * matrix.columnCount();
+			for (uint32_t c = 0; c < matrix.columnCount(); c++) row[c] = state.weight(matrix.Columns[c]);
+		}
+	}, 1);
+}
+
+//Fills the matrix by dijkstraRows(). Graph with negative edge weights is reweighted with Johnson's potentials,
+//then weights of the matrix are converted back to the original ones.
+static void dijkstraMatrix(const CsrGraph& graph, ThreadPool& pool, DistanceMatrix& matrix, ApspResult& result) {
+	if (std::all_of(graph.Weights.begin(), graph.Weights.end(), [](weight_t w) { return w >= 0; })) {
+		dijkstraRows(graph, pool, matrix);
+		result.ResultCode = AlgoResultCode::Ok;
+		return;
+	}
+	JohnsonPotentials potentials;
+	if (!computePotentials(graph, potentials, result.NegativeCycle)) {
+		result.ResultCode = AlgoResultCode::NegativeLoopFound;
+		return;
+	}
+	CsrGraph reweighted = graph;
+	reweightGraph(reweighted, potentials);
+	dijkstraRows(reweighted, pool, matrix);
+	pool.parallelFor(matrix.rowCount(), [&](size_t begin, size_t end, unsigned) {
+		for (size_t r = begin; r < end; r++) {
+			weight_t* row = matrix.Weights.data() + r * matrix.columnCount();
+			for (uint32_t c = 0; c < matrix.columnCount(); c++) row[c] = potentials.originalWeight(matrix.Rows[r], matrix.Columns[c], row[c]);
+		}
+	}, 64);
+	result.ResultCode = AlgoResultCode::Ok;
+}
+
+//Sets rows and columns of the matrix and allocates its weights
+static void shapeMatrix(DistanceMatrix& matrix, const std::vector<uint32_t>& rows, const std::vector<uint32_t>& columns) {
+	matrix.Rows = rows;
+	matrix.Columns = columns;
+	matrix.Weights.assign(rows.size() * columns.size(), INFINITE_WEIGHT);
+}
+
+ApspMethod selectApspMethod(const CsrGraph& graph) {
+	//Floyd-Warshall makes |V|^3 vectorized min-plus steps, Dijkstra searches make about |V| * (|E| + |V|) * log|V| steps.
+	//Step of a search (edge relaxation and heap sift) takes about as long as 8 min-plus steps.
+	double n = graph.vertexCount();
+	double searches = n * (graph.edgeCount() + n) * std::log2(n + 1);
+	return n * n * n < 8 * searches ? ApspMethod::FloydWarshall : ApspMethod::Dijkstra;
+}
+
+void allPairsShortestPaths(const CsrGraph& graph, ThreadPool& pool, ApspMethod method, DistanceMatrix& matrix, ApspResult& result) {
+	uint32_t n = graph.vertexCount();
+	result.Method = method == ApspMethod::Auto ? selectApspMethod(graph) : method;
+	result.NegativeCycle.clear();
+	std::vector<uint32_t> vertices(n);
+	for (uint32_t v = 0; v < n; v++) vertices[v] = v;
+	shapeMatrix(matrix, vertices, vertices);
+
+	if (result.Method == ApspMethod::Dijkstra) {
+		dijkstraMatrix(graph, pool, matrix, result);
+		return;
+	}
+	floydWarshall(graph, pool, matrix.Weights);
+	bool negative_loop = false;
+	for (uint32_t v = 0; v < n; v++) negative_loop = negative_loop || matrix.Weights[size_t(v) * n + v] < 0;
+	if (negative_loop) {
+		//Loop itself is found by a Bellman-Ford family search
+		QueryWorkspace workspace;
+		findNegativeCycle(graph, CSR_NO_VERTEX, workspace, result.NegativeCycle);
+		result.ResultCode = AlgoResultCode::NegativeLoopFound;
+		return;
+	}
+	result.ResultCode = AlgoResultCode::Ok;
+}
+
+void distanceMatrix(const CsrGraph& graph, ThreadPool& pool, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets,
+		DistanceMatrix& matrix, ApspResult& result) {
+	result.Method = ApspMethod::Dijkstra;
+	result.NegativeCycle.clear();
+	shapeMatrix(matrix, sources, targets);
+	dijkstraMatrix(graph, pool, matrix, result);
+}
+
+//Entry of the bucket of a vertex: the vertex is in the backward search space of the column vertex
+struct BucketEntry {
+	uint32_t Column;   //Column of the matrix
+	weight_t Weight;   //Weight of the path from the vertex down to the column vertex
+};
+
+//Search over one direction of the hierarchy that explores the whole search space: over upward edges from start (forward search)
+//or over downward edges into start (backward search). Stalled vertices are not expanded.
+//visit(v) is called for every settled vertex that is not stalled, its weight is state.Weight[v].
+template <class Visit>
+static void hierarchySearch(const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& heads, const std::vector<weight_t>& weights,
+		const std::vector<uint32_t>& stall_offsets, const std::vector<uint32_t>& stall_heads, const std::vector<weight_t>& stall_weights,
+		uint32_t start, SearchState& state, Visit visit) {
+	uint32_t vertex_count = static_cast<uint32_t>(offsets.size() - 1);
+	QuaternaryHeapQueue& queue = state.DaryHeap;
+	state.reset(vertex_count);
+	state.touch(start);
+	state.Weight[start] = 0;
+	queue.reset(state.Weight.data(), vertex_count);
+	queue.push(start);
+	while (!queue.empty()) {
+		uint32_t v = queue.top();
+		queue.pop();
+		state.Processed[v] = true;
+		bool stalled = false;
+		for (uint32_t i = stall_offsets[v]; i < stall_offsets[v + 1] && !stalled; i++) {
+			stalled = state.weight(stall_heads[i]) + stall_weights[i] < state.Weight[v];
+		}
+		if (stalled) continue;
+		visit(v);
+		for (uint32_t i = offsets[v]; i < offsets[v + 1]; i++) {
+			uint32_t to = heads[i];
+			state.touch(to);
+			if (state.Processed[to]) continue;
+			weight_t old_weight = state.Weight[to];
+			if (old_weight > state.Weight[v] + weights[i]) {
+				state.Weight[to] = state.Weight[v] + weights[i];
+				updateQueue(queue, to, old_weight, QueueInsertion::Lazy);
+			}
+		}
+	}
+}
+
+void distanceMatrix(const ContractionHierarchy& hierarchy, ThreadPool& pool, const std::vector<uint32_t>& sources,
+		const std::vector<uint32_t>& targets, DistanceMatrix& matrix) {
+	uint32_t n = hierarchy.vertexCount();
+	shapeMatrix(matrix, sources, targets);
+	std::vector<SearchState> states(pool.size());   //State of each thread is reused by all its searches
+
+	//Backward searches from column vertices. Every thread collects (vertex, entry) pairs, then they are placed into
+	//buckets of vertices in CSR form.
+	std::vector<std::vector<std::pair<uint32_t, BucketEntry>>> entries(pool.size());
+	pool.parallelFor(matrix.columnCount(), [&](size_t begin, size_t end, unsigned thread) {
+		SearchState& state = states[thread];
+		for (size_t c = begin; c < end; c++) {
+			hierarchySearch(hierarchy.DownOffsets, hierarchy.DownSources, hierarchy.DownWeights,
+					hierarchy.UpOffsets, hierarchy.UpTargets, hierarchy.UpWeights, matrix.Columns[c], state, [&](uint32_t v) {
+				entries[thread].push_back(std::make_pair(v, BucketEntry{static_cast<uint32_t>(c), state.Weight[v]}));
+			});
+		}
+	}, 1);
+	std::vector<uint32_t> bucket_offsets(n + 1, 0);
+	for (const auto& list : entries) {
+		for (const auto& entry : list) bucket_offsets[entry.first + 1]++;
+	}
+	for (uint32_t v = 0; v < n; v++) bucket_offsets[v + 1] += bucket_offsets[v];
+	std::vector<BucketEntry> buckets(bucket_offsets[n]);
+	std::vector<uint32_t> next(bucket_offsets.begin(), bucket_offsets.end() - 1);
+	for (const auto& list : entries) {
+		for (const auto& entry : list) buckets[next[entry.first]++] = entry.second;
+	}
+
+	//Forward searches from row vertices: a settled vertex joins the forward path with the downward paths of its bucket
+	pool.parallelFor(matrix.rowCount(), [&](size_t begin, size_t end, unsigned thread) {
+		SearchState& state = states[thread];
+		for (size_t r = begin; r < end; r++) {
+			weight_t* row = matrix.Weights.data() + r * matrix.columnCount();
+			hierarchySearch(hierarchy.UpOffsets, hierarchy.UpTargets, hierarchy.UpWeights,
+					hierarchy.DownOffsets, hierarchy.DownSources, hierarchy.DownWeights, matrix.Rows[r], state, [&](uint32_t v) {
+				weight_t weight = state.Weight[v];
+				for (uint32_t i = bucket_offsets[v]; i < bucket_offsets[v + 1]; i++) {
+					row[buckets[i].Column] = std::min(row[buckets[i].Column], weight + buckets[i].Weight);
+				}
+			});
+		}
+	}, 1);
+}
+
+//Distance matrix file: signature, row count, column count, vertex indices of rows, vertex indices of columns, weights
+static const char DISTANCE_MATRIX_FILE_SIGNATURE[8] = {'G', 'C', 'D', 'M', 'v', '1', 0, 0};
+
+int saveDistanceMatrix(const DistanceMatrix& matrix, const std::string& path) {
+	std::ofstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	uint32_t counts[2] = {matrix.rowCount(), matrix.columnCount()};
+	file.write(DISTANCE_MATRIX_FILE_SIGNATURE, sizeof(DISTANCE_MATRIX_FILE_SIGNATURE));
+	file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+	file.write(reinterpret_cast<const char*>(matrix.Rows.data()), matrix.Rows.size() * sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(matrix.Columns.data()), matrix.Columns.size() * sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(matrix.Weights.data()), matrix.Weights.size() * sizeof(weight_t));
+	return file ? NO_ERROR : FATAL_ERROR_FILE_WRITE_FAILURE;
+}
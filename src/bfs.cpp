@@ -0,0 +1,204 @@
+/*
+ * bfs.cpp
+ *
+ *  Direction-optimizing breadth-first search.
+ */
+
+#include <vector>
+#include "bfs.h"
+
+//Access to Graph needed by the search
+struct GraphBfsAdapter {
+	const Graph& G;
+	Callback Notify;
+	void* UserContext;
+
+	vertex_id_t vertexCount() const { return G.idCount(); }
+	bool exists(vertex_id_t v) const { return G.VerticesById[v] != nullptr; }
+	uint64_t outDegree(vertex_id_t v) const { return G.VerticesById[v]->OutcomingEdges->size(); }
+	uint64_t inDegree(vertex_id_t v) const { return G.VerticesById[v]->IncomingEdges->size(); }
+	uint64_t edgeCount() const {
+		uint64_t count = 0;
+		for (const auto& pair : G) count += pair.second->OutcomingEdges->size();
+		return count;
+	}
+	//Calls f(to) for successors of v until it returns true
+	template <class F> void forEachSuccessor(vertex_id_t v, F f) const {
+		for (const auto& e : *(G.VerticesById[v]->OutcomingEdges)) {
+			if (f(e->ToVertex->Id)) return;
+		}
+	}
+	//Calls f(from) for predecessors of v until it returns true
+	template <class F> void forEachPredecessor(vertex_id_t v, F f) const {
+		for (const auto& e : *(G.VerticesById[v]->IncomingEdges)) {
+			if (f(e->FromVertex->Id)) return;
+		}
+	}
+	void notify(AlgoEvent event, vertex_id_t v) const {
+		if (Notify) Notify(event, v == NO_VERTEX_ID ? nullptr : G.VerticesById[v], UserContext);
+	}
+};
+
+//Access to CsrGraph needed by the search
+struct CsrBfsAdapter {
+	const CsrGraph& G;
+	CsrCallback Notify;
+	void* UserContext;
+
+	uint32_t vertexCount() const { return G.vertexCount(); }
+	bool exists(uint32_t) const { return true; }
+	uint64_t outDegree(uint32_t v) const { return G.Offsets[v + 1] - G.Offsets[v]; }
+	uint64_t inDegree(uint32_t v) const { return G.ReverseOffsets[v + 1] - G.ReverseOffsets[v]; }
+	uint64_t edgeCount() const { return G.edgeCount(); }
+	template <class F> void forEachSuccessor(uint32_t v, F f) const {
+		for (uint32_t i = G.Offsets[v]; i < G.Offsets[v + 1]; i++) {
+			if (f(G.Targets[i])) return;
+		}
+	}
+	template <class F> void forEachPredecessor(uint32_t v, F f) const {
+		for (uint32_t i = G.ReverseOffsets[v]; i < G.ReverseOffsets[v + 1]; i++) {
+			if (f(G.Sources[i])) return;
+		}
+	}
+	void notify(AlgoEvent event, uint32_t v) const {
+		if (Notify) Notify(event, v, UserContext);
+	}
+};
+
+static bool testBit(const std::vector<uint64_t>& bits, vertex_id_t v) { return (bits[v >> 6] >> (v & 63)) & 1; }
+static void setBit(std::vector<uint64_t>& bits, vertex_id_t v) { bits[v >> 6] |= uint64_t(1) << (v & 63); }
+
+template <class Adapter>
+static void directionOptimizingSearch(const Adapter& graph, vertex_id_t source, vertex_id_t target, QueryWorkspace& workspace,
+		BfsResult& result, double alpha, double beta) {
+	vertex_id_t vertex_count = graph.vertexCount();
+	if (source >= vertex_count || target >= vertex_count || !graph.exists(source) || !graph.exists(target)) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	}
+
+	SearchState& state = workspace.Forward;
+	state.reset(vertex_count);
+	size_t word_count = (vertex_count + 63) / 64;
+	std::vector<uint64_t> visited(word_count, 0);
+	std::vector<uint64_t> frontier_bits, next_bits;    //used by bottom-up steps only
+	std::vector<vertex_id_t> frontier, next;           //used by top-down steps only
+
+	state.touch(source);
+	state.Weight[source] = 0;
+	setBit(visited, source);
+	frontier.push_back(source);
+	size_t frontier_size = 1, previous_size = 0;
+	uint64_t frontier_edges = graph.outDegree(source);                  //edges to check from the frontier
+	uint64_t unvisited_edges = graph.edgeCount() - graph.inDegree(source);   //edges to check to unvisited vertices
+	bool bottom_up = false;
+	bool found = false;
+
+	for (uint32_t level = 1; frontier_size > 0 && !found; level++) {
+		size_t next_size = 0;
+		uint64_t next_edges = 0, next_in_edges = 0;
+
+		//Mark vertex v found at this level with given parent
+		auto visit = [&](vertex_id_t v, vertex_id_t parent) {
+			setBit(visited, v);
+			state.touch(v);
+			state.Weight[v] = level;
+			state.Parent[v] = parent;
+			next_size++;
+			next_edges += graph.outDegree(v);
+			next_in_edges += graph.inDegree(v);
+			graph.notify(AlgoEvent::VertexDiscovered, v);
+			if (v == target) found = true;
+		};
+
+		bool growing = frontier_size > previous_size;
+		if (!bottom_up && growing && frontier_edges > unvisited_edges / alpha && frontier_size >= vertex_count / beta) {
+			bottom_up = true;
+			frontier_bits.assign(word_count, 0);
+			for (vertex_id_t v : frontier) setBit(frontier_bits, v);
+		}
+		else if (bottom_up && !growing && frontier_size < vertex_count / beta) {
+			bottom_up = false;
+			frontier.clear();
+			for (size_t w = 0; w < word_count; w++) {
+				for (uint64_t bits = frontier_bits[w]; bits; bits &= bits - 1) {
+					frontier.push_back(static_cast<vertex_id_t>(w * 64 + __builtin_ctzll(bits)));
+				}
+			}
+		}
+
+		if (bottom_up) {
+			result.BottomUpSteps++;
+			result.TopDownEdges += frontier_edges;
+			next_bits.assign(word_count, 0);
+			//Target is looked at first: the search is over if it has a parent in the frontier
+			graph.forEachPredecessor(target, [&](vertex_id_t from) {
+				result.EdgesExamined++;
+				if (!testBit(frontier_bits, from)) return false;
+				visit(target, from);
+				return true;
+			});
+			for (size_t w = 0; w < word_count && !found; w++) {
+				for (uint64_t bits = ~visited[w]; bits && !found; bits &= bits - 1) {
+					vertex_id_t v = static_cast<vertex_id_t>(w * 64 + __builtin_ctzll(bits));
+					if (v >= vertex_count) break;
+					if (!graph.exists(v)) continue;
+					graph.forEachPredecessor(v, [&](vertex_id_t from) {
+						result.EdgesExamined++;
+						if (!testBit(frontier_bits, from)) return false;
+						visit(v, from);
+						setBit(next_bits, v);
+						return true;
+					});
+				}
+			}
+			frontier_bits.swap(next_bits);
+		}
+		else {
+			result.TopDownSteps++;
+			next.clear();
+			for (size_t i = 0; i < frontier.size() && !found; i++) {
+				vertex_id_t v = frontier[i];
+				graph.forEachSuccessor(v, [&](vertex_id_t to) {
+					result.EdgesExamined++;
+					result.TopDownEdges++;
+					if (!testBit(visited, to)) {
+						visit(to, v);
+						next.push_back(to);
+					}
+					return found;
+				});
+			}
+			frontier.swap(next);
+		}
+
+		unvisited_edges -= next_in_edges;
+		previous_size = frontier_size;
+		frontier_size = next_size;
+		frontier_edges = next_edges;
+	}
+
+	if (found) {
+		graph.notify(AlgoEvent::TargetFound, target);
+		result.ResultCode = AlgoResultCode::Found;
+	}
+	else {
+		graph.notify(AlgoEvent::TargetNotFound, NO_VERTEX_ID);
+		result.ResultCode = AlgoResultCode::NotFound;
+	}
+	graph.notify(AlgoEvent::AlgorithmFinished, NO_VERTEX_ID);
+}
+
+void directionOptimizingBfs(vertex_id_t source, vertex_id_t target, const Graph& graph, QueryWorkspace& workspace,
+		Callback callback, BfsResult& result, void* user_context, double alpha, double beta) {
+	directionOptimizingSearch(GraphBfsAdapter{graph, callback, user_context}, source, target, workspace, result, alpha, beta);
+}
+
+void directionOptimizingBfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, BfsResult& result, void* user_context, double alpha, double beta) {
+	directionOptimizingSearch(CsrBfsAdapter{graph, callback, user_context}, source, target, workspace, result, alpha, beta);
+}
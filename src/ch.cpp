@@ -0,0 +1,407 @@
+/*
+ * ch.cpp
+ *
+ *  Contraction hierarchies: preprocessing that adds shortcut edges and fast point-to-point queries over them.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include "ch.h"
+#include "error.h"
+
+uint32_t ContractionHierarchy::shortcutCount() const {
+	uint32_t count = 0;
+	for (uint32_t middle : UpMiddles) count += middle != CSR_NO_VERTEX;
+	for (uint32_t middle : DownMiddles) count += middle != CSR_NO_VERTEX;
+	return count;
+}
+
+//Edge of the graph being contracted
+struct OverlayEdge {
+	uint32_t Vertex;   //The other end of the edge
+	weight_t Weight;
+	uint32_t Middle;   //Contracted vertex the shortcut passes, CSR_NO_VERTEX for original edge
+};
+
+//Maximum number of vertices processed by a witness search when vertex is contracted
+constexpr uint32_t WITNESS_SEARCH_LIMIT = 500;
+//The same when the number of shortcuts is only estimated for vertex priority
+constexpr uint32_t PRIORITY_WITNESS_SEARCH_LIMIT = 50;
+
+//Graph of not yet contracted vertices with shortcuts, and the state of witness searches
+class Overlay {
+public:
+	std::vector<std::vector<OverlayEdge>> Out;   //Outcoming edges of vertex
+	std::vector<std::vector<OverlayEdge>> In;    //Incoming edges of vertex
+
+	explicit Overlay(const CsrGraph& graph) : Out(graph.vertexCount()), In(graph.vertexCount()),
+			Weight_(graph.vertexCount(), INFINITE_WEIGHT), Target_(graph.vertexCount(), false) {
+		for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+			for (uint32_t i = graph.Offsets[v]; i < graph.Offsets[v + 1]; i++) {
+				if (graph.Targets[i] != v) addEdge(v, graph.Targets[i], graph.Weights[i], CSR_NO_VERTEX);
+			}
+		}
+	}
+
+	//Adds edge from->to or makes existing one lighter
+	void addEdge(uint32_t from, uint32_t to, weight_t weight, uint32_t middle) {
+		for (auto& e : Out[from]) {
+			if (e.Vertex != to) continue;
+			if (e.Weight > weight) {
+				e.Weight = weight;
+				e.Middle = middle;
+				for (auto& r : In[to]) {
+					if (r.Vertex == from) {
+						r.Weight = weight;
+						r.Middle = middle;
+					}
+				}
+			}
+			return;
+		}
+		Out[from].push_back(OverlayEdge{to, weight, middle});
+		In[to].push_back(OverlayEdge{from, weight, middle});
+	}
+
+	//Calls shortcut(u, w, weight) for every pair of neighbors u->v->w of v that needs a shortcut when v is contracted
+	//limit - maximum number of vertices processed by a witness search
+	template <class Shortcut>
+	void findShortcuts(uint32_t v, uint32_t limit, Shortcut shortcut) {
+		for (const auto& in : In[v]) {
+			weight_t max_weight = -1;
+			for (const auto& out : Out[v]) {
+				if (out.Vertex != in.Vertex) max_weight = std::max(max_weight, in.Weight + out.Weight);
+			}
+			if (max_weight < 0) continue;
+			witnessSearch(in.Vertex, v, max_weight, limit);
+			for (const auto& out : Out[v]) {
+				if (out.Vertex != in.Vertex && Weight_[out.Vertex] > in.Weight + out.Weight) {
+					shortcut(in.Vertex, out.Vertex, in.Weight + out.Weight);
+				}
+			}
+		}
+	}
+
+	//Removes edges of contracted vertex v from its neighbors
+	void remove(uint32_t v) {
+		auto is_v = [v](const OverlayEdge& e) { return e.Vertex == v; };
+		for (const auto& e : Out[v]) {
+			auto& edges = In[e.Vertex];
+			edges.erase(std::remove_if(edges.begin(), edges.end(), is_v), edges.end());
+		}
+		for (const auto& e : In[v]) {
+			auto& edges = Out[e.Vertex];
+			edges.erase(std::remove_if(edges.begin(), edges.end(), is_v), edges.end());
+		}
+		Out[v].clear();
+		Out[v].shrink_to_fit();
+		In[v].clear();
+		In[v].shrink_to_fit();
+	}
+
+private:
+	std::vector<weight_t> Weight_;     //Path weights found by the last witness search
+	std::vector<uint32_t> Touched_;    //Vertices with weights set by the last witness search
+	std::vector<bool> Target_;         //Neighbors of the vertex being contracted, the last witness search looks for
+
+	//Dijkstra from source that avoids vertex skip and stops at paths heavier than max_weight
+	//or when paths to all other neighbors of skip are final
+	void witnessSearch(uint32_t source, uint32_t skip, weight_t max_weight, uint32_t limit) {
+		for (uint32_t v : Touched_) Weight_[v] = INFINITE_WEIGHT;
+		Touched_.clear();
+		uint32_t targets = 0;
+		for (const auto& e : Out[skip]) {
+			if (e.Vertex != source && !Target_[e.Vertex]) {
+				Target_[e.Vertex] = true;
+				targets++;
+			}
+		}
+		typedef std::pair<weight_t, uint32_t> Entry;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+		Weight_[source] = 0;
+		Touched_.push_back(source);
+		queue.push(Entry(0, source));
+		uint32_t processed = 0;
+		while (!queue.empty() && processed < limit && targets > 0) {
+			Entry top = queue.top();
+			queue.pop();
+			if (top.first > Weight_[top.second]) continue;
+			if (top.first > max_weight) break;
+			processed++;
+			if (Target_[top.second]) {
+				Target_[top.second] = false;
+				targets--;
+			}
+			for (const auto& e : Out[top.second]) {
+				if (e.Vertex == skip) continue;
+				weight_t weight = top.first + e.Weight;
+				if (weight < Weight_[e.Vertex]) {
+					if (Weight_[e.Vertex] == INFINITE_WEIGHT) Touched_.push_back(e.Vertex);
+					Weight_[e.Vertex] = weight;
+					queue.push(Entry(weight, e.Vertex));
+				}
+			}
+		}
+		for (const auto& e : Out[skip]) Target_[e.Vertex] = false;
+	}
+};
+
+bool buildContractionHierarchy(const CsrGraph& graph, ContractionHierarchy& hierarchy) {
+	hierarchy = ContractionHierarchy();
+	for (weight_t w : graph.Weights) {
+		if (w < 0) return false;
+	}
+	uint32_t vertex_count = graph.vertexCount();
+	Overlay overlay(graph);
+	std::vector<uint32_t> contracted_neighbors(vertex_count, 0), level(vertex_count, 0);
+	auto priority = [&](uint32_t v) {
+		int64_t shortcuts = 0;
+		overlay.findShortcuts(v, PRIORITY_WITNESS_SEARCH_LIMIT, [&shortcuts](uint32_t, uint32_t, weight_t) { shortcuts++; });
+		int64_t edges = overlay.In[v].size() + overlay.Out[v].size();
+		return shortcuts - edges + contracted_neighbors[v] + level[v];
+	};
+
+	typedef std::pair<int64_t, uint32_t> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	for (uint32_t v = 0; v < vertex_count; v++) queue.push(Entry(priority(v), v));
+
+	//Edges of the hierarchy: edges of vertex to its neighbors that remain when it is contracted
+	std::vector<std::vector<OverlayEdge>> up(vertex_count), down(vertex_count);
+	hierarchy.Rank.assign(vertex_count, 0);
+	uint32_t rank = 0;
+	std::vector<std::tuple<uint32_t, uint32_t, weight_t>> shortcuts;
+	while (!queue.empty()) {
+		uint32_t v = queue.top().second;
+		queue.pop();
+		//Lazy update: put the vertex back if its priority has grown
+		int64_t current = priority(v);
+		if (!queue.empty() && current > queue.top().first) {
+			queue.push(Entry(current, v));
+			continue;
+		}
+
+		shortcuts.clear();
+		overlay.findShortcuts(v, WITNESS_SEARCH_LIMIT, [&shortcuts](uint32_t u, uint32_t w, weight_t weight) { shortcuts.emplace_back(u, w, weight); });
+		for (const auto& s : shortcuts) overlay.addEdge(std::get<0>(s), std::get<1>(s), std::get<2>(s), v);
+		hierarchy.Rank[v] = rank++;
+		up[v] = overlay.Out[v];
+		down[v] = overlay.In[v];
+		for (const auto& edges : {&overlay.Out[v], &overlay.In[v]}) {
+			for (const auto& e : *edges) {
+				contracted_neighbors[e.Vertex]++;
+				level[e.Vertex] = std::max(level[e.Vertex], level[v] + 1);
+			}
+		}
+		overlay.remove(v);
+	}
+
+	auto flatten = [vertex_count](const std::vector<std::vector<OverlayEdge>>& lists, std::vector<uint32_t>& offsets,
+			std::vector<uint32_t>& ends, std::vector<weight_t>& weights, std::vector<uint32_t>& middles) {
+		offsets.assign(vertex_count + 1, 0);
+		for (uint32_t v = 0; v < vertex_count; v++) offsets[v + 1] = offsets[v] + static_cast<uint32_t>(lists[v].size());
+		ends.reserve(offsets[vertex_count]);
+		weights.reserve(offsets[vertex_count]);
+		middles.reserve(offsets[vertex_count]);
+		for (const auto& list : lists) {
+			for (const auto& e : list) {
+				ends.push_back(e.Vertex);
+				weights.push_back(e.Weight);
+				middles.push_back(e.Middle);
+			}
+		}
+	};
+	flatten(up, hierarchy.UpOffsets, hierarchy.UpTargets, hierarchy.UpWeights, hierarchy.UpMiddles);
+	flatten(down, hierarchy.DownOffsets, hierarchy.DownSources, hierarchy.DownWeights, hierarchy.DownMiddles);
+	return true;
+}
+
+//Hierarchy file: signature, graph fingerprint, vertex count, upward and downward edge counts, then arrays
+static const char HIERARCHY_FILE_SIGNATURE[8] = {'G', 'C', 'C', 'H', 'v', '1', 0, 0};
+
+template <class T>
+static void writeArray(std::ofstream& file, const std::vector<T>& array) {
+	file.write(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T));
+}
+
+template <class T>
+static void readArray(std::ifstream& file, std::vector<T>& array, size_t size) {
+	array.resize(size);
+	file.read(reinterpret_cast<char*>(array.data()), size * sizeof(T));
+}
+
+int saveContractionHierarchy(const ContractionHierarchy& hierarchy, const CsrGraph& graph, const std::string& path) {
+	std::ofstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	uint64_t fingerprint = graphFingerprint(graph);
+	uint32_t counts[3] = {hierarchy.vertexCount(), static_cast<uint32_t>(hierarchy.UpTargets.size()),
+			static_cast<uint32_t>(hierarchy.DownSources.size())};
+	file.write(HIERARCHY_FILE_SIGNATURE, sizeof(HIERARCHY_FILE_SIGNATURE));
+	file.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+	file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+	writeArray(file, hierarchy.Rank);
+	writeArray(file, hierarchy.UpOffsets);
+	writeArray(file, hierarchy.UpTargets);
+	writeArray(file, hierarchy.UpWeights);
+	writeArray(file, hierarchy.UpMiddles);
+	writeArray(file, hierarchy.DownOffsets);
+	writeArray(file, hierarchy.DownSources);
+	writeArray(file, hierarchy.DownWeights);
+	writeArray(file, hierarchy.DownMiddles);
+	return file ? NO_ERROR : FATAL_ERROR_FILE_WRITE_FAILURE;
+}
+
+int loadContractionHierarchy(ContractionHierarchy& hierarchy, const CsrGraph& graph, const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	char signature[sizeof(HIERARCHY_FILE_SIGNATURE)];
+	uint64_t fingerprint = 0;
+	uint32_t counts[3] = {0, 0, 0};
+	file.read(signature, sizeof(signature));
+	file.read(reinterpret_cast<char*>(&fingerprint), sizeof(fingerprint));
+	file.read(reinterpret_cast<char*>(counts), sizeof(counts));
+	if (!file || !std::equal(signature, signature + sizeof(signature), HIERARCHY_FILE_SIGNATURE)) return FATAL_ERROR_FILE_READ_FAILURE;
+	if (counts[0] != graph.vertexCount() || fingerprint != graphFingerprint(graph)) return FATAL_ERROR_PREPROCESSED_DATA_MISMATCH;
+	readArray(file, hierarchy.Rank, counts[0]);
+	readArray(file, hierarchy.UpOffsets, counts[0] + 1);
+	readArray(file, hierarchy.UpTargets, counts[1]);
+	readArray(file, hierarchy.UpWeights, counts[1]);
+	readArray(file, hierarchy.UpMiddles, counts[1]);
+	readArray(file, hierarchy.DownOffsets, counts[0] + 1);
+	readArray(file, hierarchy.DownSources, counts[2]);
+	readArray(file, hierarchy.DownWeights, counts[2]);
+	readArray(file, hierarchy.DownMiddles, counts[2]);
+	if (!file || hierarchy.UpOffsets[counts[0]] != counts[1] || hierarchy.DownOffsets[counts[0]] != counts[2]) {
+		hierarchy = ContractionHierarchy();
+		return FATAL_ERROR_FILE_READ_FAILURE;
+	}
+	return NO_ERROR;
+}
+
+template <class Queue>
+static void chSearch(const ContractionHierarchy& hierarchy, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		Queue& forward_queue, Queue& backward_queue, CsrCallback callback, ChResult& result, void* user_context) {
+	uint32_t vertex_count = hierarchy.vertexCount();
+	if (source >= vertex_count || target >= vertex_count) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	}
+	SearchState& forward = workspace.Forward;
+	SearchState& backward = workspace.Backward;
+	forward.reset(vertex_count);
+	backward.reset(vertex_count);
+	forward.touch(source);
+	backward.touch(target);
+	forward.Weight[source] = 0;
+	backward.Weight[target] = 0;
+	forward_queue.reset(forward.Weight.data(), vertex_count);
+	backward_queue.reset(backward.Weight.data(), vertex_count);
+	forward_queue.push(source);
+	backward_queue.push(target);
+	result.ResultCode = AlgoResultCode::NotFound;
+
+	bool forward_step = true;
+	for (;;) {
+		bool forward_active = !forward_queue.empty() && forward.Weight[forward_queue.top()] < result.PathWeight;
+		bool backward_active = !backward_queue.empty() && backward.Weight[backward_queue.top()] < result.PathWeight;
+		if (!forward_active && !backward_active) break;
+		if (!forward_active) forward_step = false;
+		if (!backward_active) forward_step = true;
+
+		SearchState& state = forward_step ? forward : backward;
+		SearchState& other = forward_step ? backward : forward;
+		Queue& queue = forward_step ? forward_queue : backward_queue;
+		//Edges the search goes by and edges into the vertex from higher vertices (used by stall check)
+		const std::vector<uint32_t>& offsets = forward_step ? hierarchy.UpOffsets : hierarchy.DownOffsets;
+		const std::vector<uint32_t>& heads = forward_step ? hierarchy.UpTargets : hierarchy.DownSources;
+		const std::vector<weight_t>& weights = forward_step ? hierarchy.UpWeights : hierarchy.DownWeights;
+		const std::vector<uint32_t>& stall_offsets = forward_step ? hierarchy.DownOffsets : hierarchy.UpOffsets;
+		const std::vector<uint32_t>& stall_heads = forward_step ? hierarchy.DownSources : hierarchy.UpTargets;
+		const std::vector<weight_t>& stall_weights = forward_step ? hierarchy.DownWeights : hierarchy.UpWeights;
+		forward_step = !forward_step;
+
+		uint32_t v = queue.top();
+		queue.pop();
+		state.Processed[v] = true;
+		if (other.weight(v) < INFINITE_WEIGHT && state.Weight[v] + other.Weight[v] < result.PathWeight) {
+			result.PathWeight = state.Weight[v] + other.Weight[v];
+			result.MeetingVertex = v;
+		}
+
+		//Stall on demand: a higher vertex gives a lighter path to v, so paths through v are not minimal
+		bool stalled = false;
+		for (uint32_t i = stall_offsets[v]; i < stall_offsets[v + 1] && !stalled; i++) {
+			stalled = state.weight(stall_heads[i]) + stall_weights[i] < state.Weight[v];
+		}
+		if (stalled) continue;
+
+		if (callback) callback(AlgoEvent::VertexProcessingStarted, v, user_context);
+		for (uint32_t i = offsets[v]; i < offsets[v + 1]; i++) {
+			uint32_t to = heads[i];
+			state.touch(to);
+			if (state.Processed[to]) continue;
+			if (callback) callback(AlgoEvent::VertexDiscovered, to, user_context);
+			weight_t old_weight = state.Weight[to];
+			if (old_weight > state.Weight[v] + weights[i]) {
+				state.Weight[to] = state.Weight[v] + weights[i];
+				state.Parent[to] = v;
+				updateQueue(queue, to, old_weight, QueueInsertion::Lazy);
+			}
+		}
+		if (callback) callback(AlgoEvent::VertexProcessingFinished, v, user_context);
+	}
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+	if (result.PathWeight < INFINITE_WEIGHT) result.ResultCode = AlgoResultCode::Found;
+}
+
+void chQuery(const ContractionHierarchy& hierarchy, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, ChResult& result, void* user_context) {
+	withSelectedQueue(workspace, true, [&](auto& forward_queue, auto& backward_queue) {
+		chSearch(hierarchy, source, target, workspace, forward_queue, backward_queue, callback, result, user_context);
+	});
+}
+
+//Appends vertices of hierarchy edge from->to in the original graph to path, except from
+static void unpackEdge(const ContractionHierarchy& hierarchy, uint32_t from, uint32_t to, std::vector<uint32_t>& path) {
+	uint32_t middle = CSR_NO_VERTEX;
+	if (hierarchy.Rank[to] > hierarchy.Rank[from]) {
+		for (uint32_t i = hierarchy.UpOffsets[from]; i < hierarchy.UpOffsets[from + 1]; i++) {
+			if (hierarchy.UpTargets[i] == to) middle = hierarchy.UpMiddles[i];
+		}
+	}
+	else {
+		for (uint32_t i = hierarchy.DownOffsets[to]; i < hierarchy.DownOffsets[to + 1]; i++) {
+			if (hierarchy.DownSources[i] == from) middle = hierarchy.DownMiddles[i];
+		}
+	}
+	if (middle == CSR_NO_VERTEX) {
+		path.push_back(to);
+		return;
+	}
+	unpackEdge(hierarchy, from, middle, path);
+	unpackEdge(hierarchy, middle, to, path);
+}
+
+void unpackChPath(const ContractionHierarchy& hierarchy, const QueryWorkspace& workspace, uint32_t source, uint32_t target,
+		const ChResult& result, std::vector<uint32_t>& path) {
+	path.clear();
+	if (result.ResultCode != AlgoResultCode::Found) return;
+	//Path in the hierarchy: source..meeting vertex by forward parents, meeting vertex..target by backward parents
+	std::vector<uint32_t> hierarchy_path;
+	for (uint32_t v = result.MeetingVertex; v != source; v = workspace.Forward.parent(v)) hierarchy_path.push_back(v);
+	hierarchy_path.push_back(source);
+	std::reverse(hierarchy_path.begin(), hierarchy_path.end());
+	for (uint32_t v = result.MeetingVertex; v != target;) {
+		v = workspace.Backward.parent(v);
+		hierarchy_path.push_back(v);
+	}
+
+	path.push_back(source);
+	for (size_t i = 1; i < hierarchy_path.size(); i++) unpackEdge(hierarchy, hierarchy_path[i - 1], hierarchy_path[i], path);
+}
@@ -0,0 +1,792 @@
+/*
+ * csr.cpp
+ *
+ *  Compressed sparse row (CSR) representation of a graph and search algorithms working on it.
+ */
+
+#include <algorithm>
+#include <queue>
+#include <stack>
+#include <cstdlib>
+#include <cmath>
+#include "csr.h"
+#include "informed.h"
+#include "landmarks.h"
+
+uint32_t CsrGraph::findVertex(const std::string& name) const {
+	auto found = NameIndex.find(name);
+	if (found != NameIndex.end()) {
+		return found->second;
+	}
+	else {
+		return CSR_NO_VERTEX;
+	}
+}
+
+//Distributes edges into adjacency arrays keeping the order of edges of every vertex
+//reverse - false to group edges by source vertex, true to group them by target vertex
+static void fillAdjacency(const std::vector<CsrEdge>& edges, uint32_t vertex_count, bool reverse,
+		std::vector<uint32_t>& offsets, std::vector<uint32_t>& adjacent, std::vector<weight_t>& weights) {
+	//count edges of every vertex, then turn counts into offsets
+	offsets.assign(vertex_count + 1, 0);
+	for (const auto& e : edges) {
+		offsets[(reverse ? e.To : e.From) + 1]++;
+	}
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		offsets[i + 1] += offsets[i];
+	}
+
+	adjacent.resize(edges.size());
+	weights.resize(edges.size());
+	std::vector<uint32_t> position(offsets.begin(), offsets.end() - 1);
+	for (const auto& e : edges) {
+		uint32_t p = position[reverse ? e.To : e.From]++;
+		adjacent[p] = reverse ? e.From : e.To;
+		weights[p] = e.Weight;
+	}
+}
+
+static void indexNames(CsrGraph& csr) {
+	csr.NameIndex.clear();
+	csr.NameIndex.reserve(csr.vertexCount());
+	for (uint32_t i = 0; i < csr.vertexCount(); i++) {
+		csr.NameIndex[csr.Names[i]] = i;
+	}
+}
+
+void buildCsrGraph(const std::vector<CsrEdge>& edges, CsrGraph& csr) {
+	indexNames(csr);
+	fillAdjacency(edges, csr.vertexCount(), false, csr.Offsets, csr.Targets, csr.Weights);
+	fillAdjacency(edges, csr.vertexCount(), true, csr.ReverseOffsets, csr.Sources, csr.ReverseWeights);
+}
+
+void buildCsrGraph(const Graph& graph, CsrGraph& csr) {
+	//CSR index of every vertex by vertex id
+	std::vector<uint32_t> index(graph.idCount(), CSR_NO_VERTEX);
+	csr.Names.clear();
+	csr.X.clear();
+	csr.Y.clear();
+	csr.Names.reserve(graph.size());
+	for (const auto& pair : graph) {
+		index[pair.second->Id] = csr.vertexCount();
+		csr.Names.push_back(pair.second->Name);
+		const Vertex2d *v2d = dynamic_cast<const Vertex2d*>(pair.second);
+		if (v2d) {
+			csr.X.push_back(v2d->X);
+			csr.Y.push_back(v2d->Y);
+		}
+	}
+	if (csr.X.size() != csr.Names.size()) {
+		csr.X.clear();
+		csr.Y.clear();
+	}
+	indexNames(csr);
+
+	//Incoming edges are taken from Vertex::IncomingEdges to keep their order
+	std::vector<CsrEdge> edges, reverse_edges;
+	for (const auto& pair : graph) {
+		uint32_t vertex = index[pair.second->Id];
+		for (const auto& e : *(pair.second->OutcomingEdges)) {
+			edges.push_back(CsrEdge{vertex, index[e->ToVertex->Id], e->Weight});
+		}
+		for (const auto& e : *(pair.second->IncomingEdges)) {
+			reverse_edges.push_back(CsrEdge{index[e->FromVertex->Id], vertex, e->Weight});
+		}
+	}
+	fillAdjacency(edges, csr.vertexCount(), false, csr.Offsets, csr.Targets, csr.Weights);
+	fillAdjacency(reverse_edges, csr.vertexCount(), true, csr.ReverseOffsets, csr.Sources, csr.ReverseWeights);
+}
+
+uint64_t graphFingerprint(const CsrGraph& graph) {
+	//FNV-1a hash
+	uint64_t hash = 14695981039346656037ULL;
+	auto add = [&hash](const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; i++) {
+			hash = (hash ^ bytes[i]) * 1099511628211ULL;
+		}
+	};
+	add(graph.Offsets.data(), graph.Offsets.size() * sizeof(uint32_t));
+	add(graph.Targets.data(), graph.Targets.size() * sizeof(uint32_t));
+	add(graph.Weights.data(), graph.Weights.size() * sizeof(weight_t));
+	return hash;
+}
+
+bool hasNonNegativeIntegerWeights(const CsrGraph& graph) {
+	for (weight_t w : graph.Weights) {
+		if (w < 0 || w != floor(w)) return false;
+	}
+	return true;
+}
+
+static bool checkSourceAndTarget(const CsrGraph& graph, uint32_t source, uint32_t target, AlgoResult& result) {
+	if (source >= graph.vertexCount() || target >= graph.vertexCount()) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return false;
+	};
+
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return false;
+	};
+	return true;
+}
+
+//Common part of bfs and dfs: Container is either queue or stack of vertex indices
+template <class Container, class Front>
+static void csrUnweightedSearch(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, AlgoResult& result, void* user_context, Front front) {
+	if (!checkSourceAndTarget(graph, source, target, result)) return;
+	SearchState& state = workspace.Forward;
+	state.reset(graph.vertexCount());
+
+	Container q;
+	q.push(source);
+	state.touch(source);
+	state.Parent[source] = source;
+
+	while (!q.empty()) {
+		uint32_t v = front(q);
+		q.pop();
+		if (callback) callback(AlgoEvent::VertexProcessingStarted, v, user_context);
+		for (uint32_t i = graph.Offsets[v]; i < graph.Offsets[v + 1]; i++) {
+			uint32_t to = graph.Targets[i];
+			if (!state.touched(to)) {
+				state.touch(to);
+				state.Parent[to] = v;
+				q.push(to);
+				if (callback) callback(AlgoEvent::VertexDiscovered, to, user_context);
+			}
+			if (to == target) {
+				if (callback) callback(AlgoEvent::TargetFound, to, user_context);
+				if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+				result.ResultCode = AlgoResultCode::Found;
+				return;
+			}
+		}
+		if (callback) callback(AlgoEvent::VertexProcessingFinished, v, user_context);
+	}
+	if (callback) callback(AlgoEvent::TargetNotFound, CSR_NO_VERTEX, user_context);
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+	result.ResultCode = AlgoResultCode::NotFound;
+}
+
+void bfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, AlgoResult& result, void* user_context) {
+	csrUnweightedSearch<std::queue<uint32_t>>(graph, source, target, workspace, callback, result, user_context,
+			[](std::queue<uint32_t>& q) { return q.front(); });
+}
+
+void dfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, AlgoResult& result, void* user_context) {
+	csrUnweightedSearch<std::stack<uint32_t>>(graph, source, target, workspace, callback, result, user_context,
+			[](std::stack<uint32_t>& q) { return q.top(); });
+}
+
+//Common part of dijkstra and dijkstra2d: heuristic(v) is added to the weight of path to v (0 for pure Dijkstra)
+template <class Queue, class Heuristic>
+static void csrDijkstra(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, Queue& queue,
+		CsrCallback callback, AlgoResult& result, void* user_context, Heuristic heuristic) {
+	if (source >= graph.vertexCount() || (target != CSR_NO_VERTEX && target >= graph.vertexCount())) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	}
+	SearchState& state = workspace.Forward;
+	state.reset(graph.vertexCount());
+	state.touch(source);
+	state.Weight[source] = 0;
+
+	queue.reset(state.Weight.data(), graph.vertexCount());
+	if (workspace.Insertion == QueueInsertion::Lazy) {
+		queue.push(source);
+	}
+	else {
+		for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+			state.touch(v);
+			queue.push(v);
+		}
+	}
+
+	while (!queue.empty()) {
+		uint32_t v = queue.top();
+		queue.pop();
+
+		//Dead end
+		if (state.Weight[v] == INFINITE_WEIGHT) {
+			break;
+		}
+
+		weight_t current_heuristic = heuristic(v);
+		if (callback) callback(AlgoEvent::VertexProcessingStarted, v, user_context);
+		for (uint32_t i = graph.Offsets[v]; i < graph.Offsets[v + 1]; i++) {
+			uint32_t to = graph.Targets[i];
+			state.touch(to);
+			if (state.Processed[to]) continue;
+			if (callback) callback(AlgoEvent::VertexDiscovered, to, user_context);
+
+			weight_t new_weight = state.Weight[v] + graph.Weights[i] + (heuristic(to) - current_heuristic);
+			weight_t old_weight = state.Weight[to];
+			if (old_weight > new_weight) {
+				state.Weight[to] = new_weight;
+				state.Parent[to] = v;
+				updateQueue(queue, to, old_weight, workspace.Insertion);
+			}
+		}
+		state.Processed[v] = true;
+		if (callback) callback(AlgoEvent::VertexProcessingFinished, v, user_context);
+
+		if (v == target) {
+			if (callback) callback(AlgoEvent::TargetFound, v, user_context);
+			result.ResultCode = AlgoResultCode::Found;
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			return;
+		}
+	};
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+	//Without target the queue runs out when all reachable vertices are labeled
+	result.ResultCode = target == CSR_NO_VERTEX ? AlgoResultCode::Ok : AlgoResultCode::NotFound;
+}
+
+void dijkstra(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, AlgoResult& result, void* user_context) {
+	withSelectedQueue(workspace, true, [&](auto& queue, auto&) {
+		csrDijkstra(graph, source, target, workspace, queue, callback, result, user_context, [](uint32_t) { return weight_t(0); });
+	});
+}
+
+weight_t dialMaxEdgeWeight(const CsrGraph& graph) {
+	weight_t max_weight = 0;
+	for (weight_t w : graph.Weights) {
+		if (w < 0 || w > DIAL_MAX_EDGE_WEIGHT || w != floor(w)) return -1;
+		if (w > max_weight) max_weight = w;
+	}
+	return max_weight;
+}
+
+void dialDijkstra(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, weight_t max_edge_weight, CsrCallback callback, AlgoResult& result, void* user_context) {
+	auto no_heuristic = [](uint32_t) { return weight_t(0); };
+	if (max_edge_weight < 0) {
+		csrDijkstra(graph, source, target, workspace, workspace.Forward.BinaryHeap, callback, result, user_context, no_heuristic);
+		return;
+	}
+	workspace.Forward.Dial.setMaxWeight(static_cast<uint32_t>(max_edge_weight));
+	csrDijkstra(graph, source, target, workspace, workspace.Forward.Dial, callback, result, user_context, no_heuristic);
+}
+
+void dijkstra2d(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, AlgoResult& result, void* user_context, double coefficient) {
+	//Heuristic needs target coordinates, so there is no search without target
+	if (!graph.is2d() || target >= graph.vertexCount()) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	int x_target = graph.X[target];
+	int y_target = graph.Y[target];
+	auto heuristic = [&](uint32_t v) {
+		return weight_t(abs(graph.X[v] - x_target) + abs(graph.Y[v] - y_target)) * coefficient;
+	};
+	withSelectedQueue(workspace, false, [&](auto& queue, auto&) {
+		csrDijkstra(graph, source, target, workspace, queue, callback, result, user_context, heuristic);
+	});
+}
+
+template <class Distance>
+weight_t minWeightPerDistance(const CsrGraph& graph) {
+	if (!graph.is2d()) return 0;
+	weight_t scale = INFINITE_WEIGHT;
+	for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+		for (uint32_t i = graph.Offsets[v]; i < graph.Offsets[v + 1]; i++) {
+			if (graph.Weights[i] < 0) return 0;
+			uint32_t to = graph.Targets[i];
+			double distance = Distance::of(graph.X[to] - graph.X[v], graph.Y[to] - graph.Y[v]);
+			if (distance > 0 && graph.Weights[i] / distance < scale) scale = graph.Weights[i] / distance;
+		}
+	}
+	return scale == INFINITE_WEIGHT ? 0 : scale;
+}
+
+template weight_t minWeightPerDistance<ManhattanDistance>(const CsrGraph& graph);
+template weight_t minWeightPerDistance<OctileDistance>(const CsrGraph& graph);
+template weight_t minWeightPerDistance<EuclideanDistance>(const CsrGraph& graph);
+
+template <class Queue, class Heuristic>
+static void csrAStar(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, Queue& queue,
+		const Heuristic& heuristic, CsrCallback callback, AlgoResult& result, void* user_context) {
+	if (!checkSourceAndTarget(graph, source, target, result)) return;
+	if (Heuristic::UsesCoordinates && !graph.is2d()) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	//Heuristic estimate of the path weight from v to target
+	auto estimate = [&](uint32_t v) {
+		if constexpr (Heuristic::UsesCoordinates) {
+			return heuristic(graph.X[v] - graph.X[target], graph.Y[v] - graph.Y[target]);
+		}
+		else {
+			return heuristic(v, target);
+		}
+	};
+	SearchState& state = workspace.Forward;
+	state.reset(graph.vertexCount());
+	state.allocateEstimate();
+	state.touchWithEstimate(source);
+	state.Weight[source] = 0;
+	state.Estimate[source] = estimate(source);
+
+	queue.reset(state.Estimate.data(), graph.vertexCount());
+	if (workspace.Insertion == QueueInsertion::Lazy) {
+		queue.push(source);
+	}
+	else {
+		for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+			state.touchWithEstimate(v);
+			queue.push(v);
+		}
+	}
+
+	while (!queue.empty()) {
+		uint32_t v = queue.top();
+		queue.pop();
+
+		//Dead end
+		if (state.Estimate[v] == INFINITE_WEIGHT) {
+			break;
+		}
+
+		if (callback) callback(AlgoEvent::VertexProcessingStarted, v, user_context);
+		for (uint32_t i = graph.Offsets[v]; i < graph.Offsets[v + 1]; i++) {
+			uint32_t to = graph.Targets[i];
+			state.touchWithEstimate(to);
+			if (state.Processed[to]) continue;
+			if (callback) callback(AlgoEvent::VertexDiscovered, to, user_context);
+
+			weight_t new_weight = state.Weight[v] + graph.Weights[i];
+			if (state.Weight[to] > new_weight) {
+				weight_t old_estimate = state.Estimate[to];
+				state.Weight[to] = new_weight;
+				state.Estimate[to] = new_weight + estimate(to);
+				state.Parent[to] = v;
+				updateQueue(queue, to, old_estimate, workspace.Insertion);
+			}
+		}
+		state.Processed[v] = true;
+		if (callback) callback(AlgoEvent::VertexProcessingFinished, v, user_context);
+
+		if (v == target) {
+			if (callback) callback(AlgoEvent::TargetFound, v, user_context);
+			result.ResultCode = AlgoResultCode::Found;
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			return;
+		}
+	};
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+	result.ResultCode = AlgoResultCode::NotFound;
+}
+
+template <class Heuristic>
+void aStar(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, const Heuristic& heuristic, CsrCallback callback, AlgoResult& result, void* user_context) {
+	withSelectedQueue(workspace, false, [&](auto& queue, auto&) {
+		csrAStar(graph, source, target, workspace, queue, heuristic, callback, result, user_context);
+	});
+}
+
+template void aStar<ZeroHeuristic>(const CsrGraph&, uint32_t, uint32_t, QueryWorkspace&, const ZeroHeuristic&, CsrCallback, AlgoResult&, void*);
+template void aStar<ManhattanHeuristic>(const CsrGraph&, uint32_t, uint32_t, QueryWorkspace&, const ManhattanHeuristic&, CsrCallback, AlgoResult&, void*);
+template void aStar<OctileHeuristic>(const CsrGraph&, uint32_t, uint32_t, QueryWorkspace&, const OctileHeuristic&, CsrCallback, AlgoResult&, void*);
+template void aStar<EuclideanHeuristic>(const CsrGraph&, uint32_t, uint32_t, QueryWorkspace&, const EuclideanHeuristic&, CsrCallback, AlgoResult&, void*);
+template void aStar<LandmarkHeuristic>(const CsrGraph&, uint32_t, uint32_t, QueryWorkspace&, const LandmarkHeuristic&, CsrCallback, AlgoResult&, void*);
+
+//Finds a cycle in the graph of parents of a Bellman-Ford family search. Such a cycle always has negative weight.
+//Walks go up the parents from every vertex and stop at vertices visited before, so every vertex is visited once.
+//cycle - vertices of the cycle in path order
+//Returns true if a cycle is found
+static bool findParentCycle(const SearchState& state, uint32_t vertex_count, std::vector<uint32_t>& cycle) {
+	std::vector<uint32_t> walk(vertex_count, CSR_NO_VERTEX);   //Start vertex of the walk that visited vertex
+	for (uint32_t start = 0; start < vertex_count; start++) {
+		uint32_t v = start;
+		while (v != CSR_NO_VERTEX && walk[v] == CSR_NO_VERTEX) {
+			walk[v] = start;
+			v = state.parent(v);
+		}
+		if (v != CSR_NO_VERTEX && walk[v] == start) {
+			//The walk came back to v, so v is on the cycle
+			cycle.clear();
+			uint32_t u = v;
+			do {
+				cycle.push_back(u);
+				u = state.parent(u);
+			} while (u != v);
+			std::reverse(cycle.begin(), cycle.end());
+			return true;
+		}
+	}
+	return false;
+}
+
+void bellmanFord(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, CsrBellmanFordResult& result, void* user_context) {
+	if (!checkSourceAndTarget(graph, source, target, result)) return;
+	SearchState& state = workspace.Forward;
+	state.reset(graph.vertexCount());
+	uint32_t vertex_count = graph.vertexCount();
+	for (uint32_t v = 0; v < vertex_count; v++) {
+		state.touch(v);
+	}
+	state.Weight[source] = 0;
+	result.NegativeCycle.clear();
+
+	//n+1 times as last time is for negative loop check. If a pass changes nothing, weights are final and the rest are skipped.
+	for (uint32_t i = 0; i <= vertex_count; i++) {
+		bool changed = false;
+		uint32_t changed_vertex = CSR_NO_VERTEX;
+		for (uint32_t v = 0; v < vertex_count; v++) {
+			for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+				uint32_t to = graph.Targets[j];
+				weight_t new_weight = state.Weight[v] + graph.Weights[j];
+				if (state.Weight[to] > new_weight) {
+					state.Weight[to] = new_weight;
+					state.Parent[to] = v;
+					changed = true;
+					changed_vertex = v;
+				}
+			}
+		}
+		if (!changed) break;
+		//Parents form a cycle only if there is a negative loop: the check after every pass finds it long before pass n+1
+		if (findParentCycle(state, vertex_count, result.NegativeCycle) || i == vertex_count) {
+			uint32_t v = result.NegativeCycle.empty() ? changed_vertex : result.NegativeCycle.front();
+			if (callback) callback(AlgoEvent::NegativeLoopDetected, v, user_context);
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			result.ResultCode = AlgoResultCode::NegativeLoopFound;
+			return;
+		}
+	}
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+	result.ResultCode = (state.Weight[target] < INFINITE_WEIGHT) ?
+			AlgoResultCode::Found :
+			AlgoResultCode::NotFound;
+}
+
+//Queue-based Bellman-Ford with subtree disassembly (Tarjan). Vertices with improved path weight are kept in a FIFO queue.
+//Tree of parents is kept as a list of vertices in preorder with their depths. When weight of v improves, the subtree of v
+//is taken out of the tree: weights of its vertices are stale, so they are not scanned until they improve too.
+//If vertex u that improves weight of v is in the subtree of v, edge u->v closes a negative loop.
+//source - source vertex. If it is CSR_NO_VERTEX, all vertices start with weight 0 (as if there was a vertex with zero weight
+//         edges to all of them), so any negative loop of the graph is found.
+//state - resulting weights and parents
+//cycle - vertices of the negative loop in path order, empty if there is no loop
+static void spfaSearch(const CsrGraph& graph, uint32_t source, SearchState& state, std::vector<uint32_t>& cycle) {
+	uint32_t vertex_count = graph.vertexCount();
+	state.reset(vertex_count);
+	for (uint32_t v = 0; v < vertex_count; v++) {
+		state.touch(v);
+	}
+	cycle.clear();
+
+	//Preorder list is circular, root is an extra entry vertex_count: parent of source or of all vertices.
+	uint32_t root = vertex_count;
+	std::vector<uint32_t> next(vertex_count + 1, root), prev(vertex_count + 1, root), depth(vertex_count + 1, 0);
+	std::vector<bool> in_tree(vertex_count + 1, false);
+	//Puts v to the tree right after parent, i.e. as its first child
+	auto attach = [&](uint32_t v, uint32_t parent) {
+		next[v] = next[parent];
+		prev[v] = parent;
+		prev[next[parent]] = v;
+		next[parent] = v;
+		depth[v] = depth[parent] + 1;
+		in_tree[v] = true;
+	};
+	//FIFO of vertices with improved path weight. Processed marks vertices in the queue, so a vertex is there at most once
+	//and vertex_count slots of the circular buffer are enough.
+	std::vector<uint32_t> queue(vertex_count);
+	uint32_t head = 0, count = 0;
+	auto push = [&](uint32_t v) {
+		uint32_t tail = head + count;
+		queue[tail >= vertex_count ? tail - vertex_count : tail] = v;
+		count++;
+		state.Processed[v] = true;
+	};
+
+	in_tree[root] = true;
+	for (uint32_t v = 0; v < vertex_count; v++) {
+		if (source != CSR_NO_VERTEX && v != source) continue;
+		state.Weight[v] = 0;
+		attach(v, root);
+		push(v);
+	}
+
+	while (count > 0) {
+		uint32_t u = queue[head];
+		head = head + 1 == vertex_count ? 0 : head + 1;
+		count--;
+		state.Processed[u] = false;
+		if (!in_tree[u]) continue;
+		for (uint32_t j = graph.Offsets[u]; j < graph.Offsets[u + 1]; j++) {
+			uint32_t v = graph.Targets[j];
+			weight_t new_weight = state.Weight[u] + graph.Weights[j];
+			if (!(state.Weight[v] > new_weight)) continue;
+			if (v == u) {
+				cycle.push_back(u);
+				return;
+			}
+			if (in_tree[v]) {
+				uint32_t x = next[v];
+				while (depth[x] > depth[v]) {
+					if (x == u) {
+						for (uint32_t y = u; y != v; y = state.Parent[y]) cycle.push_back(y);
+						cycle.push_back(v);
+						std::reverse(cycle.begin(), cycle.end());
+						return;
+					}
+					in_tree[x] = false;
+					x = next[x];
+				}
+				next[prev[v]] = x;
+				prev[x] = prev[v];
+			}
+			state.Weight[v] = new_weight;
+			state.Parent[v] = u;
+			attach(v, u);
+			if (!state.Processed[v]) push(v);
+		}
+	}
+}
+
+void spfa(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, CsrBellmanFordResult& result, void* user_context) {
+	if (!checkSourceAndTarget(graph, source, target, result)) return;
+	spfaSearch(graph, source, workspace.Forward, result.NegativeCycle);
+	if (!result.NegativeCycle.empty()) {
+		if (callback) callback(AlgoEvent::NegativeLoopDetected, result.NegativeCycle.front(), user_context);
+		if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+		result.ResultCode = AlgoResultCode::NegativeLoopFound;
+		return;
+	}
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+	result.ResultCode = (workspace.Forward.Weight[target] < INFINITE_WEIGHT) ?
+			AlgoResultCode::Found :
+			AlgoResultCode::NotFound;
+}
+
+bool findNegativeCycle(const CsrGraph& graph, uint32_t source, QueryWorkspace& workspace, std::vector<uint32_t>& cycle) {
+	cycle.clear();
+	if (source != CSR_NO_VERTEX && source >= graph.vertexCount()) return false;
+	spfaSearch(graph, source, workspace.Forward, cycle);
+	return !cycle.empty();
+}
+
+template <class Queue>
+static void bidirectionalDijkstraSearch(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, Queue& forward_queue, Queue& backward_queue, CsrCallback callback, CsrBidirectionalResult& result, void* user_context) {
+	if (!checkSourceAndTarget(graph, source, target, result)) return;
+	SearchState& forward = workspace.Forward;
+	SearchState& backward = workspace.Backward;
+	forward.reset(graph.vertexCount());
+	backward.reset(graph.vertexCount());
+	forward.touch(source);
+	backward.touch(target);
+	forward.Weight[source] = 0;
+	backward.Weight[target] = 0;
+	result.ResultCode = AlgoResultCode::NotFound;
+
+	forward_queue.reset(forward.Weight.data(), graph.vertexCount());
+	backward_queue.reset(backward.Weight.data(), graph.vertexCount());
+	if (workspace.Insertion == QueueInsertion::Lazy) {
+		forward_queue.push(source);
+		backward_queue.push(target);
+	}
+	else {
+		for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+			forward.touch(v);
+			backward.touch(v);
+			forward_queue.push(v);
+			backward_queue.push(v);
+		}
+	}
+
+	weight_t shortest_path_weight = INFINITE_WEIGHT, new_path_weight;
+	uint32_t forward_shortest_path_vertex = CSR_NO_VERTEX, backward_shortest_path_vertex = CSR_NO_VERTEX;
+	weight_t shortest_path_bridge_weight = INFINITE_WEIGHT;
+
+	while (!forward_queue.empty() && !backward_queue.empty()) {
+		uint32_t forward_current = forward_queue.top();
+		uint32_t backward_current = backward_queue.top();
+
+		weight_t best_forward_search = forward.Weight[forward_current];
+		weight_t best_backward_search = backward.Weight[backward_current];
+		//If path found and there no candidates to be shortest. It is checked before dead end: the path found is the shortest
+		//one if a search has nothing more to process.
+		if (shortest_path_weight < INFINITE_WEIGHT && shortest_path_weight < best_forward_search + best_backward_search) {
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			result.ForwardSearchLastVertex = forward_shortest_path_vertex;
+			result.BackwardSearchLastVertex = backward_shortest_path_vertex;
+			result.ConnectingEdgeWeight = shortest_path_bridge_weight;
+			result.ResultCode = AlgoResultCode::Found;
+			return;
+		}
+
+		//Dead end check
+		if (forward.Weight[forward_current] == INFINITE_WEIGHT) {
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			result.ResultCode = AlgoResultCode::NotFound;
+			return;
+		}
+
+		//process current vertex in forward search. It is taken from the queue first: a neighbor reached by zero weight edge
+		//gets the same key and may become the top.
+		forward_queue.pop();
+		if (callback) callback(AlgoEvent::VertexProcessingStarted, forward_current, user_context);
+		for (uint32_t i = graph.Offsets[forward_current]; i < graph.Offsets[forward_current + 1]; i++) {
+			uint32_t neighbor = graph.Targets[i];
+			forward.touch(neighbor);
+			//if this vertex is already processed no need to process it again
+			if (forward.Processed[neighbor]) continue;
+			if (callback) callback(AlgoEvent::VertexDiscovered, neighbor, user_context);
+
+			//release edge - update neighbor vertex weight and parent
+			weight_t old_weight = forward.Weight[neighbor];
+			if (old_weight > forward.Weight[forward_current] + graph.Weights[i]) {
+				forward.Weight[neighbor] = forward.Weight[forward_current] + graph.Weights[i];
+				forward.Parent[neighbor] = forward_current;
+				updateQueue(forward_queue, neighbor, old_weight, workspace.Insertion);
+			}
+
+			//if neighbor vertex is already processed by backward search check weather we have new shortest path!
+			if (backward.processed(neighbor)) {
+				new_path_weight = backward.Weight[neighbor] + graph.Weights[i] + forward.Weight[forward_current];
+				if (new_path_weight < shortest_path_weight) {
+					shortest_path_weight = new_path_weight;
+					forward_shortest_path_vertex = forward_current;
+					backward_shortest_path_vertex = neighbor;
+					shortest_path_bridge_weight = graph.Weights[i];
+				}
+			}
+		}
+		forward.Processed[forward_current] = true;
+		if (callback) callback(AlgoEvent::VertexProcessingFinished, forward_current, user_context);
+
+		if (shortest_path_weight < INFINITE_WEIGHT && shortest_path_weight < best_forward_search + best_backward_search) {
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			result.ForwardSearchLastVertex = forward_shortest_path_vertex;
+			result.BackwardSearchLastVertex = backward_shortest_path_vertex;
+			result.ConnectingEdgeWeight = shortest_path_bridge_weight;
+			result.ResultCode = AlgoResultCode::Found;
+			return;
+		}
+
+		//Dead end found
+		if (backward.Weight[backward_current] == INFINITE_WEIGHT) {
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			result.ResultCode = AlgoResultCode::NotFound;
+			return;
+		}
+
+		//process current vertex in backward search
+		if (!backward_queue.empty()) {
+			backward_queue.pop();
+			if (callback) callback(AlgoEvent::VertexProcessingStarted, backward_current, user_context);
+			for (uint32_t i = graph.ReverseOffsets[backward_current]; i < graph.ReverseOffsets[backward_current + 1]; i++) {
+				uint32_t neighbor = graph.Sources[i];
+				backward.touch(neighbor);
+				//if this vertex is already processed no need to process it again
+				if (backward.Processed[neighbor]) continue;
+				if (callback) callback(AlgoEvent::VertexDiscovered, neighbor, user_context);
+
+				//release edge - update neighbor vertex weight and parent
+				weight_t old_weight = backward.Weight[neighbor];
+				if (old_weight > backward.Weight[backward_current] + graph.ReverseWeights[i]) {
+					backward.Weight[neighbor] = backward.Weight[backward_current] + graph.ReverseWeights[i];
+					backward.Parent[neighbor] = backward_current;
+					updateQueue(backward_queue, neighbor, old_weight, workspace.Insertion);
+				}
+
+				//if neighbor vertex is already processed by forward search check weather we have new shortest path!
+				if (forward.processed(neighbor)) {
+					new_path_weight = forward.Weight[neighbor] + graph.ReverseWeights[i] + backward.Weight[backward_current];
+					if (new_path_weight < shortest_path_weight) {
+						shortest_path_weight = new_path_weight;
+						forward_shortest_path_vertex = neighbor;
+						backward_shortest_path_vertex = backward_current;
+						shortest_path_bridge_weight = graph.ReverseWeights[i];
+					}
+				}
+			}
+			backward.Processed[backward_current] = true;
+			if (callback) callback(AlgoEvent::VertexProcessingFinished, backward_current, user_context);
+		};
+	}
+	//In lazy insertion mode a queue runs out when everything reachable is explored, the path may be already found
+	if (shortest_path_weight < INFINITE_WEIGHT) {
+		result.ForwardSearchLastVertex = forward_shortest_path_vertex;
+		result.BackwardSearchLastVertex = backward_shortest_path_vertex;
+		result.ConnectingEdgeWeight = shortest_path_bridge_weight;
+		result.ResultCode = AlgoResultCode::Found;
+	}
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+}
+
+void bidirectionalDijkstra(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, CsrBidirectionalResult& result, void* user_context) {
+	withSelectedQueue(workspace, true, [&](auto& forward_queue, auto& backward_queue) {
+		bidirectionalDijkstraSearch(graph, source, target, workspace, forward_queue, backward_queue, callback, result, user_context);
+	});
+}
+
+void bidirectionalBfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, CsrBidirectionalResult& result, void* user_context) {
+	if (!checkSourceAndTarget(graph, source, target, result)) return;
+	SearchState& forward = workspace.Forward;
+	SearchState& backward = workspace.Backward;
+	forward.reset(graph.vertexCount());
+	backward.reset(graph.vertexCount());
+	forward.touch(source);
+	backward.touch(target);
+	forward.Weight[source] = 0;
+	backward.Weight[target] = 0;
+
+	std::vector<uint32_t> forward_frontier(1, source), backward_frontier(1, target), next;
+	weight_t shortest_path_length = INFINITE_WEIGHT;
+	result.ResultCode = AlgoResultCode::NotFound;
+
+	while (!forward_frontier.empty() && !backward_frontier.empty()) {
+		//expand a whole level of the smaller frontier
+		bool is_forward = forward_frontier.size() <= backward_frontier.size();
+		SearchState& own = is_forward ? forward : backward;
+		SearchState& other = is_forward ? backward : forward;
+		std::vector<uint32_t>& frontier = is_forward ? forward_frontier : backward_frontier;
+		const std::vector<uint32_t>& offsets = is_forward ? graph.Offsets : graph.ReverseOffsets;
+		const std::vector<uint32_t>& neighbors = is_forward ? graph.Targets : graph.Sources;
+		const std::vector<weight_t>& weights = is_forward ? graph.Weights : graph.ReverseWeights;
+		next.clear();
+		for (uint32_t v : frontier) {
+			if (callback) callback(AlgoEvent::VertexProcessingStarted, v, user_context);
+			for (uint32_t i = offsets[v]; i < offsets[v + 1]; i++) {
+				uint32_t neighbor = neighbors[i];
+				//the searches met: path goes through edge i
+				if (other.touched(neighbor) && own.Weight[v] + 1 + other.Weight[neighbor] < shortest_path_length) {
+					shortest_path_length = own.Weight[v] + 1 + other.Weight[neighbor];
+					result.ForwardSearchLastVertex = is_forward ? v : neighbor;
+					result.BackwardSearchLastVertex = is_forward ? neighbor : v;
+					result.ConnectingEdgeWeight = weights[i];
+				}
+				if (own.touched(neighbor)) continue;
+				own.touch(neighbor);
+				own.Weight[neighbor] = own.Weight[v] + 1;
+				own.Parent[neighbor] = v;
+				next.push_back(neighbor);
+				if (callback) callback(AlgoEvent::VertexDiscovered, neighbor, user_context);
+			}
+			if (callback) callback(AlgoEvent::VertexProcessingFinished, v, user_context);
+		}
+		frontier.swap(next);
+
+		//every path not seen yet is longer than the ones found at this level
+		if (shortest_path_length < INFINITE_WEIGHT) {
+			if (callback) callback(AlgoEvent::TargetFound, target, user_context);
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			result.ResultCode = AlgoResultCode::Found;
+			return;
+		}
+	}
+	if (callback) callback(AlgoEvent::TargetNotFound, CSR_NO_VERTEX, user_context);
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+}
@@ -4,11 +4,12 @@
  *  Created on: 3 . 2020 .
  *      Author: Serkin
  */
+#include <cmath>
 #include "graph.h"
 
 Edge* addEdge (Vertex *from, Vertex *to, const double weight, Graph &graph, const Settings& settings) {
 	if (!from || !to) return nullptr;
-	if (!findVertex(from->Name, graph) || !findVertex(to->Name, graph)) return nullptr;
+	if (findVertex(from->Id, graph) != from || findVertex(to->Id, graph) != to) return nullptr;
 	if (from == to && !settings.SelfLoop)  return nullptr;
 	if (!settings.BiDirectional) {
 		for (auto it = to->OutcomingEdges->begin(); it != to->OutcomingEdges->end(); it++) {
@@ -26,6 +27,21 @@ Edge* addEdge (Vertex *from, Vertex *to, const double weight, Graph &graph, cons
 	return edge;
 }
 
+Edge* addEdge (vertex_id_t from, vertex_id_t to, const double weight, Graph &graph, const Settings& settings) {
+	return addEdge(findVertex(from, graph), findVertex(to, graph), weight, graph, settings);
+}
+
+//Puts vertex to all graph tables under the given id
+static void insertVertex (Vertex *vertex, vertex_id_t id, Graph &graph) {
+	vertex->Id = id;
+	if (graph.VerticesById.size() <= id) {
+		graph.VerticesById.resize(id + 1, nullptr);
+	}
+	graph.VerticesById[id] = vertex;
+	graph.NameIds[vertex->Name] = id;
+	graph.Vertices[vertex->Name] = vertex;
+}
+
 bool addVertex (Vertex *vertex, Graph &graph, const Settings& settings) {
 	if (findVertex(vertex->Name, graph)) {
 		return false;
@@ -35,7 +51,7 @@ bool addVertex (Vertex *vertex, Graph &graph, const Settings& settings) {
 		if ((*ite)->ToVertex == (*ite)->FromVertex && !settings.SelfLoop) return false;
 		if ((*ite)->Weight > settings.MaxEdgeWeight || (*ite)->Weight < settings.MinEdgeWeight) return false;
 	}
-	graph[vertex->Name] = vertex;
+	insertVertex(vertex, graph.idCount(), graph);
 	return true;
 }
 
@@ -53,38 +69,63 @@ Vertex* addVertex (const string &name, Graph &graph, const Settings& settings) {
 
 void removeVertex (Vertex **ppvertex, Graph &graph) {
 	PVertex pvertex = (*ppvertex);
-	graph.erase(pvertex->Name);
+	graph.Vertices.erase(pvertex->Name);
+	graph.NameIds.erase(pvertex->Name);
+	graph.VerticesById[pvertex->Id] = nullptr;
 	delete pvertex;
 	ppvertex = nullptr;
 }
 
 Vertex* findVertex(const string &name, const Graph &graph) {
-	auto found = graph.find(name);
-	if (found != graph.end()) {
-		return found->second;
+	vertex_id_t id = findVertexId(name, graph);
+	if (id != NO_VERTEX_ID) {
+		return graph.VerticesById[id];
+	}
+	else {
+		return nullptr;
+	}
+}
+
+Vertex* findVertex(vertex_id_t id, const Graph &graph) {
+	if (id < graph.idCount()) {
+		return graph.VerticesById[id];
 	}
 	else {
 		return nullptr;
 	}
 }
 
+vertex_id_t findVertexId(const string &name, const Graph &graph) {
+	auto found = graph.NameIds.find(name);
+	if (found != graph.NameIds.end()) {
+		return found->second;
+	}
+	else {
+		return NO_VERTEX_ID;
+	}
+}
+
+bool hasNonNegativeIntegerWeights(const Graph &graph) {
+	for (const auto &pair : graph) {
+		for (const auto &e : *(pair.second->OutcomingEdges)) {
+			if (e->Weight < 0 || e->Weight != floor(e->Weight)) return false;
+		}
+	}
+	return true;
+}
+
 Graph& cloneGraph(const Graph &graph) {
 	Graph *clone_graph = new Graph();
+	clone_graph->VerticesById.resize(graph.idCount(), nullptr);
 	for (auto& pair : graph) {
-		Vertex *original_vertex = pair.second;
-		Vertex *clone_vertex = findVertex(original_vertex->Name, *clone_graph);
-		if (!clone_vertex) {
-			clone_vertex = original_vertex->edgelessClone();
-			(*clone_graph)[pair.first] = clone_vertex;
-		}
+		insertVertex(pair.second->edgelessClone(), pair.second->Id, *clone_graph);
+	}
 
+	for (auto& pair : graph) {
+		Vertex *original_vertex = pair.second;
+		Vertex *clone_vertex = clone_graph->VerticesById[original_vertex->Id];
 		for (auto original_edge : *original_vertex->OutcomingEdges) {
-			Vertex *original_target_vertex = original_edge->ToVertex;
-			Vertex *clone_target_vertex = findVertex(original_target_vertex->Name, *clone_graph);
-			if (!clone_target_vertex) {
-				clone_target_vertex = original_target_vertex->edgelessClone();
-				(*clone_graph)[original_target_vertex->Name] = clone_target_vertex;
-			}
+			Vertex *clone_target_vertex = clone_graph->VerticesById[original_edge->ToVertex->Id];
 			Edge *clone_edge = new Edge(clone_vertex, clone_target_vertex, original_edge->Weight);
 			clone_vertex->OutcomingEdges->push_back(clone_edge);
 			clone_target_vertex->IncomingEdges->push_back(clone_edge);
@@ -97,5 +138,7 @@ void clearGraph(Graph &graph) {
 	for (auto& pair : graph) {
 		delete pair.second;
 	}
-	graph.clear();
+	graph.Vertices.clear();
+	graph.NameIds.clear();
+	graph.VerticesById.clear();
 }
@@ -0,0 +1,259 @@
+/*
+ * hublabels.cpp
+ *
+ *  Hub labeling (2-hop labels): distance queries answered by intersecting two sorted labels instead of a search.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include "hublabels.h"
+#include "error.h"
+
+uint32_t HubLabels::maxLabelSize() const {
+	uint32_t max_size = 0;
+	for (uint32_t v = 0; v < vertexCount(); v++) {
+		uint32_t size = Out.Offsets[v + 1] - Out.Offsets[v] + In.Offsets[v + 1] - In.Offsets[v] - 2;
+		max_size = std::max(max_size, size);
+	}
+	return max_size;
+}
+
+size_t HubLabels::memorySize() const {
+	size_t size = (Order.size() + Rank.size()) * sizeof(uint32_t);
+	for (const HubLabelArrays* arrays : {&Out, &In}) {
+		size += (arrays->Offsets.size() + arrays->Hubs.size() + arrays->Parents.size()) * sizeof(uint32_t)
+				+ arrays->Weights.size() * sizeof(weight_t);
+	}
+	return size;
+}
+
+//Label entry while labels are built
+struct HubLabelEntry {
+	uint32_t Hub;
+	weight_t Weight;
+	uint32_t Parent;
+};
+
+//Pruned Dijkstra search of pruned landmark labeling
+class PrunedSearch {
+public:
+	explicit PrunedSearch(uint32_t vertex_count) : Weight_(vertex_count, INFINITE_WEIGHT), Parent_(vertex_count, CSR_NO_VERTEX),
+			HubWeight_(vertex_count, INFINITE_WEIGHT) {}
+
+	//Search from hub of given rank over outcoming edges (reverse is false) or incoming edges (reverse is true).
+	//Reached vertices get the hub in labels, own_labels are labels of the other direction used to check coverage:
+	//path from hub to v (reverse is false) is covered if some hub x gives hub->x in own_labels[hub] and x->v in labels[v].
+	void run(const CsrGraph& graph, uint32_t hub, uint32_t rank, bool reverse,
+			std::vector<std::vector<HubLabelEntry>>& labels, const std::vector<std::vector<HubLabelEntry>>& own_labels) {
+		const std::vector<uint32_t>& offsets = reverse ? graph.ReverseOffsets : graph.Offsets;
+		const std::vector<uint32_t>& heads = reverse ? graph.Sources : graph.Targets;
+		const std::vector<weight_t>& weights = reverse ? graph.ReverseWeights : graph.Weights;
+		for (const auto& e : own_labels[hub]) HubWeight_[e.Hub] = e.Weight;
+
+		typedef std::pair<weight_t, uint32_t> Entry;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+		Weight_[hub] = 0;
+		Touched_.push_back(hub);
+		queue.push(Entry(0, hub));
+		while (!queue.empty()) {
+			Entry top = queue.top();
+			queue.pop();
+			uint32_t v = top.second;
+			if (top.first > Weight_[v]) continue;
+			if (v != hub && covered(labels[v], top.first)) continue;
+			labels[v].push_back(HubLabelEntry{rank, top.first, v == hub ? CSR_NO_VERTEX : Parent_[v]});
+			for (uint32_t i = offsets[v]; i < offsets[v + 1]; i++) {
+				uint32_t to = heads[i];
+				weight_t weight = top.first + weights[i];
+				if (weight < Weight_[to]) {
+					if (Weight_[to] == INFINITE_WEIGHT) Touched_.push_back(to);
+					Weight_[to] = weight;
+					Parent_[to] = v;
+					queue.push(Entry(weight, to));
+				}
+			}
+		}
+
+		for (uint32_t v : Touched_) Weight_[v] = INFINITE_WEIGHT;
+		Touched_.clear();
+		for (const auto& e : own_labels[hub]) HubWeight_[e.Hub] = INFINITE_WEIGHT;
+	}
+
+private:
+	std::vector<weight_t> Weight_;      //Path weights of the current search
+	std::vector<uint32_t> Parent_;      //Parents of the current search
+	std::vector<uint32_t> Touched_;     //Vertices with weights set by the current search
+	std::vector<weight_t> HubWeight_;   //Weights of label entries of the current hub by hub rank
+
+	bool covered(const std::vector<HubLabelEntry>& label, weight_t weight) const {
+		for (const auto& e : label) {
+			if (HubWeight_[e.Hub] + e.Weight <= weight) return true;
+		}
+		return false;
+	}
+};
+
+static void flattenLabels(const std::vector<std::vector<HubLabelEntry>>& labels, HubLabelArrays& arrays) {
+	uint32_t vertex_count = static_cast<uint32_t>(labels.size());
+	arrays.Offsets.assign(vertex_count + 1, 0);
+	for (uint32_t v = 0; v < vertex_count; v++) arrays.Offsets[v + 1] = arrays.Offsets[v] + static_cast<uint32_t>(labels[v].size()) + 1;
+	size_t size = arrays.Offsets[vertex_count];
+	arrays.Hubs.reserve(size);
+	arrays.Weights.reserve(size);
+	arrays.Parents.reserve(size);
+	for (const auto& label : labels) {
+		for (const auto& e : label) {
+			arrays.Hubs.push_back(e.Hub);
+			arrays.Weights.push_back(e.Weight);
+			arrays.Parents.push_back(e.Parent);
+		}
+		arrays.Hubs.push_back(HUB_LABEL_END);
+		arrays.Weights.push_back(INFINITE_WEIGHT);
+		arrays.Parents.push_back(CSR_NO_VERTEX);
+	}
+}
+
+bool buildHubLabels(const CsrGraph& graph, HubLabels& labels) {
+	labels = HubLabels();
+	for (weight_t w : graph.Weights) {
+		if (w < 0) return false;
+	}
+	uint32_t vertex_count = graph.vertexCount();
+	labels.Order.resize(vertex_count);
+	for (uint32_t v = 0; v < vertex_count; v++) labels.Order[v] = v;
+	auto degree = [&graph](uint32_t v) {
+		return graph.Offsets[v + 1] - graph.Offsets[v] + graph.ReverseOffsets[v + 1] - graph.ReverseOffsets[v];
+	};
+	std::stable_sort(labels.Order.begin(), labels.Order.end(), [&degree](uint32_t a, uint32_t b) { return degree(a) > degree(b); });
+	labels.Rank.resize(vertex_count);
+	for (uint32_t rank = 0; rank < vertex_count; rank++) labels.Rank[labels.Order[rank]] = rank;
+
+	//Labels get hubs in order of rank, so they are sorted
+	std::vector<std::vector<HubLabelEntry>> out(vertex_count), in(vertex_count);
+	PrunedSearch search(vertex_count);
+	for (uint32_t rank = 0; rank < vertex_count; rank++) {
+		uint32_t hub = labels.Order[rank];
+		search.run(graph, hub, rank, false, in, out);
+		search.run(graph, hub, rank, true, out, in);
+	}
+	flattenLabels(out, labels.Out);
+	flattenLabels(in, labels.In);
+	return true;
+}
+
+//Hub labels file: signature, graph fingerprint, vertex count, Out and In entry counts, then arrays
+static const char HUB_LABEL_FILE_SIGNATURE[8] = {'G', 'C', 'H', 'L', 'v', '1', 0, 0};
+
+static void writeLabelArrays(std::ofstream& file, const HubLabelArrays& arrays) {
+	file.write(reinterpret_cast<const char*>(arrays.Offsets.data()), arrays.Offsets.size() * sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(arrays.Hubs.data()), arrays.Hubs.size() * sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(arrays.Weights.data()), arrays.Weights.size() * sizeof(weight_t));
+	file.write(reinterpret_cast<const char*>(arrays.Parents.data()), arrays.Parents.size() * sizeof(uint32_t));
+}
+
+static bool readLabelArrays(std::ifstream& file, uint32_t vertex_count, uint32_t entry_count, HubLabelArrays& arrays) {
+	arrays.Offsets.resize(vertex_count + 1);
+	arrays.Hubs.resize(entry_count);
+	arrays.Weights.resize(entry_count);
+	arrays.Parents.resize(entry_count);
+	file.read(reinterpret_cast<char*>(arrays.Offsets.data()), arrays.Offsets.size() * sizeof(uint32_t));
+	file.read(reinterpret_cast<char*>(arrays.Hubs.data()), arrays.Hubs.size() * sizeof(uint32_t));
+	file.read(reinterpret_cast<char*>(arrays.Weights.data()), arrays.Weights.size() * sizeof(weight_t));
+	file.read(reinterpret_cast<char*>(arrays.Parents.data()), arrays.Parents.size() * sizeof(uint32_t));
+	return file && arrays.Offsets[vertex_count] == entry_count;
+}
+
+int saveHubLabels(const HubLabels& labels, const CsrGraph& graph, const std::string& path) {
+	std::ofstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	uint64_t fingerprint = graphFingerprint(graph);
+	uint32_t counts[3] = {labels.vertexCount(), static_cast<uint32_t>(labels.Out.Hubs.size()),
+			static_cast<uint32_t>(labels.In.Hubs.size())};
+	file.write(HUB_LABEL_FILE_SIGNATURE, sizeof(HUB_LABEL_FILE_SIGNATURE));
+	file.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+	file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+	file.write(reinterpret_cast<const char*>(labels.Order.data()), labels.Order.size() * sizeof(uint32_t));
+	writeLabelArrays(file, labels.Out);
+	writeLabelArrays(file, labels.In);
+	return file ? NO_ERROR : FATAL_ERROR_FILE_WRITE_FAILURE;
+}
+
+int loadHubLabels(HubLabels& labels, const CsrGraph& graph, const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	char signature[sizeof(HUB_LABEL_FILE_SIGNATURE)];
+	uint64_t fingerprint = 0;
+	uint32_t counts[3] = {0, 0, 0};
+	file.read(signature, sizeof(signature));
+	file.read(reinterpret_cast<char*>(&fingerprint), sizeof(fingerprint));
+	file.read(reinterpret_cast<char*>(counts), sizeof(counts));
+	if (!file || !std::equal(signature, signature + sizeof(signature), HUB_LABEL_FILE_SIGNATURE)) return FATAL_ERROR_FILE_READ_FAILURE;
+	if (counts[0] != graph.vertexCount() || fingerprint != graphFingerprint(graph)) return FATAL_ERROR_PREPROCESSED_DATA_MISMATCH;
+	labels.Order.resize(counts[0]);
+	file.read(reinterpret_cast<char*>(labels.Order.data()), labels.Order.size() * sizeof(uint32_t));
+	if (!readLabelArrays(file, counts[0], counts[1], labels.Out) || !readLabelArrays(file, counts[0], counts[2], labels.In)) {
+		labels = HubLabels();
+		return FATAL_ERROR_FILE_READ_FAILURE;
+	}
+	labels.Rank.resize(counts[0]);
+	for (uint32_t rank = 0; rank < counts[0]; rank++) labels.Rank[labels.Order[rank]] = rank;
+	return NO_ERROR;
+}
+
+void hubLabelQuery(const HubLabels& labels, uint32_t source, uint32_t target, HubLabelResult& result) {
+	if (source >= labels.vertexCount() || target >= labels.vertexCount()) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	}
+	const uint32_t* out_hubs = labels.Out.Hubs.data() + labels.Out.Offsets[source];
+	const uint32_t* in_hubs = labels.In.Hubs.data() + labels.In.Offsets[target];
+	const weight_t* out_weights = labels.Out.Weights.data() + labels.Out.Offsets[source];
+	const weight_t* in_weights = labels.In.Weights.data() + labels.In.Offsets[target];
+	weight_t best = INFINITE_WEIGHT;
+	uint32_t best_hub = HUB_LABEL_END;
+	//Both labels end with HUB_LABEL_END, so the merge stops at the common end entry
+	size_t i = 0, j = 0;
+	for (;;) {
+		if (out_hubs[i] < in_hubs[j]) i++;
+		else if (out_hubs[i] > in_hubs[j]) j++;
+		else {
+			if (out_hubs[i] == HUB_LABEL_END) break;
+			if (out_weights[i] + in_weights[j] < best) {
+				best = out_weights[i] + in_weights[j];
+				best_hub = out_hubs[i];
+			}
+			i++;
+			j++;
+		}
+	}
+	result.PathWeight = best;
+	result.Hub = best_hub == HUB_LABEL_END ? CSR_NO_VERTEX : labels.Order[best_hub];
+	result.ResultCode = best_hub == HUB_LABEL_END ? AlgoResultCode::NotFound : AlgoResultCode::Found;
+}
+
+//Parent of vertex v in the entry of hub of given rank, CSR_NO_VERTEX if there is no such entry
+static uint32_t labelParent(const HubLabelArrays& arrays, uint32_t v, uint32_t rank) {
+	const uint32_t* begin = arrays.Hubs.data() + arrays.Offsets[v];
+	const uint32_t* end = arrays.Hubs.data() + arrays.Offsets[v + 1] - 1;
+	const uint32_t* entry = std::lower_bound(begin, end, rank);
+	return entry != end && *entry == rank ? arrays.Parents[entry - arrays.Hubs.data()] : CSR_NO_VERTEX;
+}
+
+void hubLabelPath(const HubLabels& labels, uint32_t source, uint32_t target, const HubLabelResult& result,
+		std::vector<uint32_t>& path) {
+	path.clear();
+	if (result.ResultCode != AlgoResultCode::Found) return;
+	uint32_t rank = labels.Rank[result.Hub];
+	//Parent of a vertex in a label entry is a vertex reached by the same pruned search, so it has the entry of the hub too
+	for (uint32_t v = source; v != result.Hub; v = labelParent(labels.Out, v, rank)) path.push_back(v);
+	path.push_back(result.Hub);
+	size_t hub_position = path.size();
+	for (uint32_t v = target; v != result.Hub; v = labelParent(labels.In, v, rank)) path.push_back(v);
+	std::reverse(path.begin() + hub_position, path.end());
+}
@@ -5,9 +5,9 @@
 #ifndef ALGO_H_
 #define ALGO_H_
 
-#include <boost/heap/binomial_heap.hpp>
 #include <map>
 #include "graph.h"
+#include "workspace.h"
 
 
 //Breadth-first search. Finds the shortest path from source to target in the sense of the minimum number of transitions between vertices.
@@ -40,20 +40,25 @@ void dfs(Vertex* source, Vertex* target, Callback callback, AlgoResult& result,
 //Dijkstra algorithm implementation. Finds the minimum weight path from source to target in a weighted graph.
 //Complexity O(|E|+|V|*log(|V|)
 //source - source vertex
-//target - target vertex
+//target - target vertex. If it is nullptr, minimum weight paths to all vertices reachable from source are found
+//         (the same result bellmanFord() gives for non-negative weights, in O(|E|+|V|*log(|V|)) instead of O(|V||E|)).
+//workspace - per-query state. Can be reused for the next query after results are no more needed.
 //callback - function that is called by algorithm to supple events to caller
-//result - result of algorithm execution: Found - path from source to target found or NotFound if no path from source to target was found
+//result - result of algorithm execution: Found - path from source to target found or NotFound if no path from source to target was found,
+//         Ok - there is no target and paths to all reachable vertices are found
 //user_context - pointer to some info - may be needed to understand the origin of event if several algorithm
 //               launches were made simultaneously
 //Way to get found path:
-//    static_cast<DijkstraContext*>(target->Context)->Parent will contain a pointer to a previous vertex.
+//    workspace.Forward.parent(target->Id) will contain id of a previous vertex.
 //    Do with it the same to get it's previous vertex. Do so until source is met.
-void dijkstra(Vertex* source, Vertex* target, Graph& graph, Callback callback,  AlgoResult& result, void* user_context = nullptr);
+//    workspace.Forward.weight(target->Id) will contain the weight of the path.
+void dijkstra(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback,  AlgoResult& result, void* user_context = nullptr);
 
 //Bidirectional Dijkstra algorithm implementation. Finds the minimum weight path from source to target in a weighted graph.
 //The search is performed from source to target and from target to source using incoming edges - Vertex::IncomingEdged should be provided for each vertex.
 //source - source vertex
 //target - target vertex
+//workspace - per-query state. Both forward and backward parts are used.
 //callback - function that is called by algorithm to supple events to caller
 //result - result of algorithm execution: Found - path from source to target found or NotFound if no path from source to target was found
 //user_context - pointer to some info - may be needed to understand the origin of event if several algorithm
@@ -62,33 +67,94 @@ void dijkstra(Vertex* source, Vertex* target, Graph& graph, Callback callback,
 //    path is represented by two parts:
 //        1) result.ForwardSearchLastVertex will contain the last vertex in minimum weight path that was found by forward search.
 //        go from it to source (opposite direction):
-//		     get previous vertex: static_cast<BidirectionalDijkstraContext*>(result.ForwardSearchLastVertex->Context)->ParentInForwardSearch
+//		     get id of previous vertex: workspace.Forward.parent(result.ForwardSearchLastVertex->Id)
 //           do so until the source is met
 //        2) result.BackwardSearchLastVertex will contain the last vertex in minimum weight path that was found by backward search.
 //        go from it to target (the direction will be the same as of path itself):
-//		     get previous vertex: static_cast<BidirectionalDijkstraContext*>(result.BackwardSearchLastVertex->Context)->ParentInBackwardSearch
+//		     get id of next vertex: workspace.Backward.parent(result.BackwardSearchLastVertex->Id)
 //           do so until the target is met
-void bidirectionalDijkstra(Vertex* source, Vertex* target, Graph& graph, Callback callback, BidirectionalDijkstraResult& result, void* user_context = nullptr);
+void bidirectionalDijkstra(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback, BidirectionalDijkstraResult& result, void* user_context = nullptr);
+
+//Bidirectional breadth-first search. Finds the shortest path from source to target in the sense of the minimum number
+//of transitions between vertices. Searches from source over outcoming edges and from target over incoming edges
+//(Vertex::IncomingEdges should be provided for each vertex), every step expands a whole level of the smaller frontier.
+//The search stops at the end of the level where the frontiers meet. On random graphs it explores about the square root
+//of the vertices forward bfs() explores.
+//Complexity O(|V| + |E|)
+//source - source vertex
+//target - target vertex
+//workspace - per-query state. Both forward and backward parts are used, Weight holds number of transitions.
+//callback - function that is called by algorithm to supple events to caller
+//result - result of algorithm execution: Found - path from source to target found or NotFound if no path from source to target was found
+//user_context - pointer to some info - may be needed to understand the origin of event if several algorithm
+//               launches were made simultaneously
+//Way to get found path is the same as for bidirectionalDijkstra(). result.ConnectingEdgeWeight is the weight of the edge
+//between result.ForwardSearchLastVertex and result.BackwardSearchLastVertex.
+void bidirectionalBfs(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback, BidirectionalDijkstraResult& result, void* user_context = nullptr);
 
 //Bellman-Ford algorithm implementation. Finds the minimum weight path from single source to *ALL* other vertices in a weighted graph.
-//Found paths and its weights are accessible using context information associated to vertices after run.
+//Found paths and its weights are accessible using workspace.Forward after run.
 //Do not send VertexDiscovered, VertexProcessingStarted and VertexProcessingFinished events as all vertices processed several times
-//Sends NegativeLoopDetected with vertex where negative loop was detected
-//Complexity O(|V||E|)
+//Sends NegativeLoopDetected with the first vertex of the negative loop
+//Complexity O(|V||E|). Passes over all edges stop as soon as one of them changes nothing.
+//After every pass parents are checked for a cycle (O(|V|)): it exists only if there is a negative loop, so the loop
+//is found long before |V| passes.
 //source - source vertex
 //target - target vertex
 //callback - function that is called by algorithm to supple events to caller
 //result - result of algorithm execution:
 //          Found - path from source to target found
 //          NotFound - no path from source to target was found
-//          NegativeLoopFound - negative loop was detected and algorithm stopped. Results (vertex context information) are undefined.
+//          NegativeLoopFound - negative loop was detected and algorithm stopped. result.NegativeCycle contains vertices of the loop
+//                              in path order (edge from the last one leads to the first one). Workspace content is undefined.
 //user_context - pointer to some info - may be needed to understand the origin of event if several algorithm
 //               launches were made simultaneously
 //Way to get found path is the same as for Dijkstra algorithm
-void bellmanFord(Vertex* source, Vertex* target, Graph& graph, Callback callback,  AlgoResult& result, void* user_context = nullptr);
+void bellmanFord(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback,  BellmanFordResult& result, void* user_context = nullptr);
+
+//Queue-based Bellman-Ford (SPFA). Only edges of vertices whose path weight was improved are relaxed again: such vertices
+//are kept in a FIFO queue, each one at most once.
+//Negative loops are found by subtree disassembly (Tarjan): when path weight of a vertex improves, its subtree in the tree
+//of parents is taken out and not scanned until it improves too. If the improving vertex is in that subtree, the edge closes
+//a negative loop, so the loop is found as soon as it appears among parents.
+//Complexity O(|V||E|) in the worst case, usually close to O(|E|).
+//Parameters, events, result and the way to get found paths are the same as for bellmanFord().
+void spfa(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Callback callback,  BellmanFordResult& result, void* user_context = nullptr);
+
+//Finds a negative loop reachable from source by spfa() search.
+//source - source vertex. If it is nullptr, search starts from all vertices, so any negative loop of the graph is found.
+//cycle - vertices of the loop in path order (edge from the last one leads to the first one), empty if there is no loop
+//If there is no loop, workspace.Forward contains minimal path weights and parents as after spfa().
+//Returns true if a negative loop is found
+bool findNegativeCycle(Vertex* source, Graph& graph, QueryWorkspace& workspace, std::vector<Vertex*>& cycle);
+
+//Maximal edge weight Dial's algorithm accepts: it needs one bucket per possible edge weight
+constexpr weight_t DIAL_MAX_EDGE_WEIGHT = 65535;
+
+//Checks whether Dial's algorithm can be applied to the graph
+//returns maximal edge weight if all edge weights are integers in range 0..DIAL_MAX_EDGE_WEIGHT, otherwise -1
+weight_t dialMaxEdgeWeight(const Graph& graph);
+
+//Dijkstra algorithm with Dial's bucket queue instead of a heap: circular array of max_edge_weight+1 buckets
+//indexed by path weight modulo bucket count. Complexity O(|E|+|V|*C) where C is max_edge_weight, no comparisons of weights.
+//max_edge_weight - result of dialMaxEdgeWeight(). If it is -1 (graph is not eligible) binary heap is used instead of buckets.
+//Other parameters and the way to get found path are the same as for dijkstra(). workspace.Queue is ignored.
+void dialDijkstra(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, weight_t max_edge_weight, Callback callback, AlgoResult& result, void* user_context = nullptr);
+
+//Overloads of the algorithms above that take source and target vertices by id.
+//Ids that don't belong to the graph give NoSourceOrTarget result. NO_VERTEX_ID target of dijkstra() and dialDijkstra()
+//means paths to all vertices.
+void bfs(vertex_id_t source, vertex_id_t target, const Graph& graph, Callback callback, AlgoResult& result, void* user_context = nullptr);
+void dfs(vertex_id_t source, vertex_id_t target, const Graph& graph, Callback callback, AlgoResult& result, void* user_context = nullptr);
+void dijkstra(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback,  AlgoResult& result, void* user_context = nullptr);
+void bidirectionalDijkstra(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback, BidirectionalDijkstraResult& result, void* user_context = nullptr);
+void bellmanFord(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback,  BellmanFordResult& result, void* user_context = nullptr);
+void spfa(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback,  BellmanFordResult& result, void* user_context = nullptr);
+void bidirectionalBfs(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback, BidirectionalDijkstraResult& result, void* user_context = nullptr);
+void dialDijkstra(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, weight_t max_edge_weight, Callback callback, AlgoResult& result, void* user_context = nullptr);
 #endif /* ALGO_H_ */
 
-//Delete all context allocated during algorithm work. Should be called after results of algorithm are no more needed
+//Reset context set by bfs() and dfs(). Should be called after results of algorithm are no more needed
 //and before next algorithm call on the same graph.
 //Graph& graph - graph
 void clearContext (Graph& graph);
@@ -0,0 +1,83 @@
+/*
+ * apsp.h
+ *
+ *  Distance matrices: all-pairs minimal path weights (blocked Floyd-Warshall, repeated Dijkstra searches) and
+ *  many-to-many weights between given sources and targets (bucket-based search over contraction hierarchy).
+ */
+
+#ifndef INC_APSP_H_
+#define INC_APSP_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csr.h"
+#include "ch.h"
+#include "parallel.h"
+
+//Matrix has vertexCount()^2 entries, so all-pairs search is limited to graphs that fit in memory (2 GB matrix)
+constexpr uint32_t APSP_MAX_VERTICES = 16384;
+
+//Weights of minimal weight paths from a set of source vertices (rows) to a set of target vertices (columns) of CsrGraph.
+//Weights are row-major: weight of the path from Rows[r] to Columns[c] is Weights[r * columnCount() + c],
+//INFINITE_WEIGHT if there is no path.
+struct DistanceMatrix {
+	std::vector<uint32_t> Rows;      //Vertex index of each row
+	std::vector<uint32_t> Columns;   //Vertex index of each column
+	std::vector<weight_t> Weights;
+
+	uint32_t rowCount() const { return static_cast<uint32_t>(Rows.size()); }
+	uint32_t columnCount() const { return static_cast<uint32_t>(Columns.size()); }
+	weight_t at(uint32_t row, uint32_t column) const { return Weights[size_t(row) * Columns.size() + column]; }
+};
+
+//Result of allPairsShortestPaths()
+struct ApspResult : AlgoResult {
+	ApspMethod Method = ApspMethod::Auto;   //Method actually used
+	std::vector<uint32_t> NegativeCycle;    //Vertices of the negative loop in path order if result is NegativeLoopFound
+};
+
+//Method of allPairsShortestPaths() for the graph: Floyd-Warshall for dense graphs, where its simple vectorized inner loop
+//beats the priority queue operations of |V| Dijkstra searches, and repeated Dijkstra for sparse ones.
+ApspMethod selectApspMethod(const CsrGraph& graph);
+
+//Weights of minimal weight paths between all pairs of vertices. Rows and columns of the matrix are all vertices in index order.
+//Floyd-Warshall: the matrix is split into square tiles. For every diagonal tile k the tile itself is updated first, then tiles
+//of row k and column k (in parallel), then all other tiles (in parallel): each of them depends on tiles of row k and column k
+//only. Inner loop of the tile update is a min-plus operation over contiguous rows that compilers vectorize.
+//Repeated Dijkstra: searches from all sources run in parallel, every search writes its weights straight to its matrix row.
+//Graphs with negative edge weights are reweighted with Johnson's potentials (johnson.h) first.
+//Negative loops are found by both methods, result is NegativeLoopFound then and the matrix is not valid.
+//graph - graph to search in, at most APSP_MAX_VERTICES vertices
+//pool - threads to use
+//method - method to use, Auto picks it with selectApspMethod()
+//matrix - resulting matrix
+//result - Ok or NegativeLoopFound
+void allPairsShortestPaths(const CsrGraph& graph, ThreadPool& pool, ApspMethod method, DistanceMatrix& matrix, ApspResult& result);
+
+//Weights of minimal weight paths from every source to every target: rows of the matrix are sources, columns are targets.
+//Dijkstra searches from all sources run in parallel, a search stops when all targets are settled. Graphs with negative edge
+//weights are reweighted with Johnson's potentials first.
+//graph - graph to search in
+//pool - threads to use
+//sources, targets - vertex indices, they may repeat
+//matrix - resulting matrix
+//result - Ok or NegativeLoopFound, method is always Dijkstra
+void distanceMatrix(const CsrGraph& graph, ThreadPool& pool, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets,
+		DistanceMatrix& matrix, ApspResult& result);
+
+//Bucket-based many-to-many search (Knopp et al.) over contraction hierarchy. Backward search from every target over downward
+//edges puts (target, weight) entry into the bucket of every vertex it settles. Forward search from every source over upward
+//edges joins the weight of every vertex it settles with the entries of its bucket: the highest vertex of a minimal weight path is
+//settled by both searches. Searches of each phase run in parallel and explore the upward search spaces only, so the cost is
+//|S| + |T| small searches instead of |S| searches over the whole graph.
+//Parameters are the same as above. The hierarchy has non-negative weights, so the result is always valid.
+void distanceMatrix(const ContractionHierarchy& hierarchy, ThreadPool& pool, const std::vector<uint32_t>& sources,
+		const std::vector<uint32_t>& targets, DistanceMatrix& matrix);
+
+//Saves the matrix to a binary file: signature, row and column counts, vertex indices of rows and columns,
+//then row-major weights (INFINITE_WEIGHT if there is no path)
+//Returns NO_ERROR or an error code (error.h)
+int saveDistanceMatrix(const DistanceMatrix& matrix, const std::string& path);
+
+#endif /* INC_APSP_H_ */
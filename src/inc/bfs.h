@@ -0,0 +1,51 @@
+/*
+ * bfs.h
+ *
+ *  Direction-optimizing breadth-first search.
+ */
+
+#ifndef INC_BFS_H_
+#define INC_BFS_H_
+
+#include <cstdint>
+#include "graph.h"
+#include "csr.h"
+
+struct BfsResult : AlgoResult {
+	uint64_t EdgesExamined = 0;   //Edges looked at by the search
+	uint64_t TopDownEdges = 0;    //Edges top-down only search would look at to reach the same levels
+	uint32_t TopDownSteps = 0;    //Number of levels expanded from frontier to its successors
+	uint32_t BottomUpSteps = 0;   //Number of levels found by looking for parents of unvisited vertices in the frontier
+};
+
+//Direction-optimizing breadth-first search (Beamer, Asanovic, Patterson). Finds the shortest path from source to target
+//in the sense of the minimum number of transitions between vertices.
+//Level by level the search either expands the frontier over outcoming edges (top-down step) or looks for a parent
+//in the frontier among incoming edges of every unvisited vertex (bottom-up step). Bottom-up step stops scanning incoming
+//edges of the vertex at the first parent found, so it examines much fewer edges when the frontier is large.
+//Frontier and visited vertices are kept in bitmaps during bottom-up steps.
+//Switch heuristic: top-down -> bottom-up when the frontier grows, is not smaller than vertex count divided by beta and
+//outcoming edges of the frontier exceed incoming edges of unvisited vertices divided by alpha;
+//bottom-up -> top-down when the frontier shrinks below vertex count divided by beta.
+//Bottom-up step checks target first, so the search stops as soon as target has a parent in the frontier.
+//Complexity O(|V| + |E|)
+//source - source vertex
+//target - target vertex
+//workspace - per-query state. Parents and numbers of transitions from source are in workspace.Forward.
+//callback - function that is called by algorithm to supple events to caller. Sends VertexDiscovered, TargetFound,
+//           TargetNotFound and AlgorithmFinished events.
+//result - result of algorithm execution and counters of examined edges
+//user_context - pointer to some info - may be needed to understand the origin of event if several algorithm
+//               launches were made simultaneously
+//alpha, beta - parameters of switch heuristic
+//Way to get found path:
+//    workspace.Forward.parent(target) contains id of a previous vertex. Do the same with it until source is met.
+//Incoming edges (Vertex::IncomingEdges) must be provided for each vertex.
+void directionOptimizingBfs(vertex_id_t source, vertex_id_t target, const Graph& graph, QueryWorkspace& workspace,
+		Callback callback, BfsResult& result, void* user_context = nullptr, double alpha = 15, double beta = 18);
+
+//The same as above, for CsrGraph. Vertices are passed by index.
+void directionOptimizingBfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, BfsResult& result, void* user_context = nullptr, double alpha = 15, double beta = 18);
+
+#endif /* INC_BFS_H_ */
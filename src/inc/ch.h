@@ -0,0 +1,82 @@
+/*
+ * ch.h
+ *
+ *  Contraction hierarchies: preprocessing that adds shortcut edges and fast point-to-point queries over them.
+ */
+
+#ifndef INC_CH_H_
+#define INC_CH_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csr.h"
+
+//Contraction hierarchy of CsrGraph. Vertices are contracted one by one in order of Rank. When a vertex is contracted,
+//shortcut edges are added between its remaining neighbors where the path through the vertex is the only minimal weight one.
+//Edges of the hierarchy (original edges and shortcuts) always go from lower to higher rank in one of two arrays:
+//upward edges v->w (Rank[w] > Rank[v]) are kept at v in Up* arrays,
+//downward edges u->v (Rank[u] > Rank[v]) are kept at their lower end v in Down* arrays, so both searches of the query go up.
+//Parallel edges are merged, the lighter one is kept.
+struct ContractionHierarchy {
+	std::vector<uint32_t> Rank;          //Position of vertex in contraction order
+	std::vector<uint32_t> UpOffsets;     //Size is vertexCount()+1
+	std::vector<uint32_t> UpTargets;     //Higher end w of edge v->w
+	std::vector<weight_t> UpWeights;
+	std::vector<uint32_t> UpMiddles;     //Contracted vertex the shortcut passes, CSR_NO_VERTEX for original edge
+	std::vector<uint32_t> DownOffsets;   //Size is vertexCount()+1
+	std::vector<uint32_t> DownSources;   //Higher end u of edge u->v
+	std::vector<weight_t> DownWeights;
+	std::vector<uint32_t> DownMiddles;   //Contracted vertex the shortcut passes, CSR_NO_VERTEX for original edge
+
+	uint32_t vertexCount() const { return static_cast<uint32_t>(Rank.size()); }
+	uint32_t edgeCount() const { return static_cast<uint32_t>(UpTargets.size() + DownSources.size()); }
+	uint32_t shortcutCount() const;
+};
+
+//Result of chQuery()
+struct ChResult : AlgoResult {
+	uint32_t MeetingVertex = CSR_NO_VERTEX;   //Vertex of the highest rank in the found path: forward and backward searches meet there
+	weight_t PathWeight = INFINITE_WEIGHT;    //Weight of the found path
+};
+
+//Contraction hierarchy preprocessing. Vertex of the least priority is contracted next, priority is
+//edge difference (shortcuts added minus edges removed) plus the number of contracted neighbors plus hierarchy level
+//(keeps contraction uniform). Priorities are updated lazily: priority of the vertex taken from the queue is recomputed
+//and the vertex is put back if it is no longer the least one.
+//Shortcut u->w is not added if a witness search (Dijkstra from u that avoids the contracted vertex, limited by the number
+//of processed vertices) finds a path not heavier than u->v->w. Limited search may add some unnecessary shortcuts but never
+//loses a path.
+//Edge weights must be non-negative.
+//graph - graph to preprocess
+//hierarchy - resulting hierarchy
+//Returns false if graph has negative edge weights
+bool buildContractionHierarchy(const CsrGraph& graph, ContractionHierarchy& hierarchy);
+
+//Saves contraction hierarchy of the graph to a binary file
+//Returns NO_ERROR or an error code (error.h)
+int saveContractionHierarchy(const ContractionHierarchy& hierarchy, const CsrGraph& graph, const std::string& path);
+
+//Loads contraction hierarchy saved by saveContractionHierarchy()
+//Returns NO_ERROR, FATAL_ERROR_PREPROCESSED_DATA_MISMATCH if the hierarchy was built for another graph or other error code (error.h)
+int loadContractionHierarchy(ContractionHierarchy& hierarchy, const CsrGraph& graph, const std::string& path);
+
+//Contraction hierarchy query. Forward search from source over upward edges and backward search from target over downward
+//edges alternate; each one stops when its queue top is not lighter than the best path found. Stalled vertices (reached
+//with non-minimal weight, as an edge from a higher vertex shows) are not expanded.
+//Vertices are always pushed into queues lazily: the search space is a small part of the graph.
+//graph - the hierarchy
+//source - source vertex
+//target - target vertex
+//workspace - per-query state. Paths in the hierarchy (with shortcuts) are in workspace.Forward and workspace.Backward.
+//callback, result, user_context - the same as for bidirectionalDijkstra()
+//Use unpackChPath() to get the found path.
+void chQuery(const ContractionHierarchy& hierarchy, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, ChResult& result, void* user_context = nullptr);
+
+//Path found by chQuery() in the original graph: shortcuts are replaced with the edges they stand for
+//path - vertices from source to target
+void unpackChPath(const ContractionHierarchy& hierarchy, const QueryWorkspace& workspace, uint32_t source, uint32_t target,
+		const ChResult& result, std::vector<uint32_t>& path);
+
+#endif /* INC_CH_H_ */
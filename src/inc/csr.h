@@ -0,0 +1,109 @@
+/*
+ * csr.h
+ *
+ *  Compressed sparse row (CSR) representation of a graph and search algorithms working on it.
+ */
+
+#ifndef INC_CSR_H_
+#define INC_CSR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "graph.h"
+#include "workspace.h"
+#include "algo.h"
+#include "informed.h"
+
+constexpr uint32_t CSR_NO_VERTEX = NO_VERTEX_ID;
+
+//Frozen (immutable) graph stored in compressed sparse row form.
+//Vertices are identified by index 0..vertexCount()-1.
+//Outcoming edges of vertex i occupy positions Offsets[i]..Offsets[i+1]-1 of Targets and Weights arrays.
+//Incoming edges of vertex i occupy positions ReverseOffsets[i]..ReverseOffsets[i+1]-1 of Sources and ReverseWeights arrays.
+//Every edge costs 12 bytes per direction (4 bytes of vertex index and 8 bytes of weight).
+struct CsrGraph {
+	std::vector<uint32_t> Offsets;          //Size is vertexCount()+1
+	std::vector<uint32_t> Targets;          //Target vertex of each outcoming edge
+	std::vector<weight_t> Weights;          //Weight of each outcoming edge
+	std::vector<uint32_t> ReverseOffsets;   //Size is vertexCount()+1
+	std::vector<uint32_t> Sources;          //Source vertex of each incoming edge
+	std::vector<weight_t> ReverseWeights;   //Weight of each incoming edge
+	std::vector<std::string> Names;         //Vertex names
+	std::vector<int> X;                     //X coordinates of vertices (empty if the graph is not 2d)
+	std::vector<int> Y;                     //Y coordinates of vertices (empty if the graph is not 2d)
+	std::unordered_map<std::string, uint32_t> NameIndex;  //Vertex name to vertex index
+
+	uint32_t vertexCount() const { return static_cast<uint32_t>(Names.size()); }
+	uint32_t edgeCount() const { return static_cast<uint32_t>(Targets.size()); }
+	bool is2d() const { return !X.empty(); }
+	//Returns index of the vertex with given name or CSR_NO_VERTEX if there is no such vertex
+	uint32_t findVertex(const std::string& name) const;
+};
+
+//Edge of the edge list CSR graph is built from
+struct CsrEdge {
+	uint32_t From;
+	uint32_t To;
+	weight_t Weight;
+};
+
+struct CsrBidirectionalResult : AlgoResult {
+	uint32_t ForwardSearchLastVertex = CSR_NO_VERTEX;    //Last vertex of the minimal weight path in forward search (before connecting edge)
+	uint32_t BackwardSearchLastVertex = CSR_NO_VERTEX;   //Last vertex of the minimal weight path in backward search (after connecting edge)
+	weight_t ConnectingEdgeWeight = INFINITE_WEIGHT;      //Weight of the edge that connects ForwardSearchLastVertex and BackwardSearchLastVertex
+};
+
+struct CsrBellmanFordResult : AlgoResult {
+	std::vector<uint32_t> NegativeCycle;   //Vertices of the negative loop in path order if result is NegativeLoopFound
+};
+
+//Callback prototype for algorithms working on CsrGraph. The same as Callback, but vertex is passed by index.
+typedef void (*CsrCallback)(AlgoEvent event, uint32_t vertex, void* user_context);
+
+//Builds CSR graph from the edge list
+//edges - edges of the graph. Edges of every vertex keep their relative order.
+//csr - graph to build. Vertex names should already be set in csr.Names (and coordinates in csr.X, csr.Y if needed)
+void buildCsrGraph(const std::vector<CsrEdge>& edges, CsrGraph& csr);
+
+//Builds CSR graph from the graph. Vertex indices follow the order of graph iteration.
+//Coordinates are copied if vertices of the graph are Vertex2d.
+void buildCsrGraph(const Graph& graph, CsrGraph& csr);
+
+//Hash of edges and their weights. Data produced by preprocessing of the graph and saved to a file keeps it
+//to check that it is loaded for the same graph.
+uint64_t graphFingerprint(const CsrGraph& graph);
+
+//Checks whether all edge weights of the graph are non-negative integers (required by radix heap and bucket queues)
+bool hasNonNegativeIntegerWeights(const CsrGraph& graph);
+
+//Algorithms below are the counterparts of the ones declared in algo.h and informed.h.
+//They work the same way and keep their per-vertex state in workspace indexed by vertex index.
+//Way to get found path:
+//    workspace.Forward.parent(target) contains index of a previous vertex. Do the same with it until source is met.
+//    Path weight (if algorithm is capable to find minimal weight path) is workspace.Forward.weight(target).
+//dijkstra() and dialDijkstra() without target (CSR_NO_VERTEX) find paths to all vertices reachable from source, result is Ok.
+void bfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, AlgoResult& result, void* user_context = nullptr);
+void dfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, AlgoResult& result, void* user_context = nullptr);
+void dijkstra(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, AlgoResult& result, void* user_context = nullptr);
+void bellmanFord(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, CsrBellmanFordResult& result, void* user_context = nullptr);
+void spfa(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, CsrBellmanFordResult& result, void* user_context = nullptr);
+//source - source vertex or CSR_NO_VERTEX to search for a negative loop anywhere in the graph
+bool findNegativeCycle(const CsrGraph& graph, uint32_t source, QueryWorkspace& workspace, std::vector<uint32_t>& cycle);
+void dijkstra2d(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, AlgoResult& result, void* user_context = nullptr, double coefficient = 0.5);
+weight_t dialMaxEdgeWeight(const CsrGraph& graph);
+void dialDijkstra(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, weight_t max_edge_weight, CsrCallback callback, AlgoResult& result, void* user_context = nullptr);
+template <class Distance>
+weight_t minWeightPerDistance(const CsrGraph& graph);
+//Coordinate heuristics require 2d graph, result is NoSourceOrTarget otherwise
+template <class Heuristic>
+void aStar(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, const Heuristic& heuristic, CsrCallback callback, AlgoResult& result, void* user_context = nullptr);
+
+//Way to get found path:
+//    result.ForwardSearchLastVertex: go to source using workspace.Forward.Parent
+//    result.BackwardSearchLastVertex: go to target using workspace.Backward.Parent
+void bidirectionalDijkstra(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, CsrBidirectionalResult& result, void* user_context = nullptr);
+void bidirectionalBfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, CsrCallback callback, CsrBidirectionalResult& result, void* user_context = nullptr);
+
+#endif /* INC_CSR_H_ */
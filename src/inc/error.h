@@ -20,6 +20,8 @@ constexpr int FATAL_ERROR_FAILED_TO_ADD_VERTEX = -8;
 constexpr int FATAL_ERROR_FAILED_TO_ADD_EDGE = -9;
 constexpr int FATAL_ERROR_UNKNOWN_FILE_TYPE = -10;
 constexpr int FATAL_ERROR_INCOMPATIBLE_ARGUMENTS = -11;
+constexpr int FATAL_ERROR_FILE_WRITE_FAILURE = -12;
+constexpr int FATAL_ERROR_PREPROCESSED_DATA_MISMATCH = -13;
 constexpr int FATAL_ERROR_SELF_LOOPS_ARE_PROHIBITED = -101;
 constexpr int FATAL_ERROR_BIDIRECTION_EDGES_ARE_PROHIBITED = -102;
 constexpr int FATAL_ERROR_EDGE_ALREADY_EXISTS = -103;
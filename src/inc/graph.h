@@ -19,7 +19,11 @@ using namespace std;
 //Add edge from one given vertex to another given vertex
 Edge* addEdge (Vertex *from, Vertex *to, const double weight, Graph &graph, const Settings& settings);
 
+//Add edge from one vertex to another, vertices are given by ids
+Edge* addEdge (vertex_id_t from, vertex_id_t to, const double weight, Graph &graph, const Settings& settings);
+
 //Add vertex to a graph
+//Vertex gets the next free id (vertex->Id)
 bool addVertex (Vertex *vertex, Graph &graph, const Settings& settings);
 
 //Create vertex and add it to a graph
@@ -32,8 +36,18 @@ void removeVertex (Vertex **vertex, Graph &graph);
 //find vertex with the given name in the graph
 Vertex* findVertex(const string &name, const Graph &graph);
 
+//find vertex with the given id in the graph
+Vertex* findVertex(vertex_id_t id, const Graph &graph);
+
+//find id of the vertex with the given name in the graph
+//returns NO_VERTEX_ID if there is no such vertex
+vertex_id_t findVertexId(const string &name, const Graph &graph);
+
+//Checks whether all edge weights of the graph are non-negative integers (required by radix heap and bucket queues)
+bool hasNonNegativeIntegerWeights(const Graph &graph);
+
 //Makes a clone of the graph
-//vertices and edge are cloned but not a context
+//vertices and edge are cloned but not a context. Cloned vertices keep their ids.
 //graph - graph to make clone from
 //returns new graph which is a clone of given
 //Graph is allocated with new expression.
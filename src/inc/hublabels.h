@@ -0,0 +1,78 @@
+/*
+ * hublabels.h
+ *
+ *  Hub labeling (2-hop labels): distance queries answered by intersecting two sorted labels instead of a search.
+ */
+
+#ifndef INC_HUBLABELS_H_
+#define INC_HUBLABELS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csr.h"
+
+//Hub rank that ends every label. It is greater than any real rank, so intersection of two labels needs no bound checks.
+constexpr uint32_t HUB_LABEL_END = UINT32_MAX;
+
+//Labels of one direction. Entries of vertex v occupy positions Offsets[v]..Offsets[v+1]-1 of all arrays: real entries
+//sorted by hub rank and HUB_LABEL_END entry. Fields are kept in separate arrays (structure of arrays), so an intersection
+//scans the contiguous Hubs arrays only and reads a weight for common hubs.
+struct HubLabelArrays {
+	std::vector<uint32_t> Offsets;   //Size is vertexCount()+1
+	std::vector<uint32_t> Hubs;      //Rank of the hub
+	std::vector<weight_t> Weights;   //Weight of minimal weight path between vertex and hub
+	std::vector<uint32_t> Parents;   //Next vertex of that path on the way to the hub, CSR_NO_VERTEX for the hub itself
+};
+
+//Hub labels of CsrGraph. For every pair of vertices s, t with a path from s to t, some hub h lies on a minimal weight
+//path from s to t and is in both Out label of s (path s->h) and In label of t (path h->t).
+struct HubLabels {
+	std::vector<uint32_t> Order;   //Vertex of each hub rank
+	std::vector<uint32_t> Rank;    //Hub rank of each vertex
+	HubLabelArrays Out;            //Hubs reachable from vertex
+	HubLabelArrays In;             //Hubs vertex is reachable from
+
+	uint32_t vertexCount() const { return static_cast<uint32_t>(Order.size()); }
+	//Number of label entries of both directions, HUB_LABEL_END entries are not counted
+	size_t entryCount() const { return Out.Hubs.size() + In.Hubs.size() - 2 * Order.size(); }
+	//Maximal number of entries in labels of one vertex (both directions)
+	uint32_t maxLabelSize() const;
+	//Memory taken by labels in bytes
+	size_t memorySize() const;
+};
+
+//Result of hubLabelQuery()
+struct HubLabelResult : AlgoResult {
+	uint32_t Hub = CSR_NO_VERTEX;             //Vertex of the common hub the minimal weight path passes
+	weight_t PathWeight = INFINITE_WEIGHT;    //Weight of the minimal weight path
+};
+
+//Pruned landmark labeling (Akiba et al.). Vertices become hubs in order of decreasing degree. For every hub a forward and
+//a backward Dijkstra search are run; a vertex reached with weight d gets the hub in its label unless labels built so far
+//already give a path not heavier than d, and then the search does not go further from it.
+//Edge weights must be non-negative.
+//graph - graph to preprocess
+//labels - resulting labels
+//Returns false if graph has negative edge weights
+bool buildHubLabels(const CsrGraph& graph, HubLabels& labels);
+
+//Saves hub labels of the graph to a binary file
+//Returns NO_ERROR or an error code (error.h)
+int saveHubLabels(const HubLabels& labels, const CsrGraph& graph, const std::string& path);
+
+//Loads hub labels saved by saveHubLabels()
+//Returns NO_ERROR, FATAL_ERROR_PREPROCESSED_DATA_MISMATCH if the labels were built for another graph or other error code (error.h)
+int loadHubLabels(HubLabels& labels, const CsrGraph& graph, const std::string& path);
+
+//Weight of minimal weight path from source to target: minimum over common hubs of Out label of source and In label of target.
+//No search and no workspace are needed. Result is Found, NotFound, SourceIsTarget or NoSourceOrTarget.
+void hubLabelQuery(const HubLabels& labels, uint32_t source, uint32_t target, HubLabelResult& result);
+
+//Path found by hubLabelQuery(): parents in Out labels lead from source to the hub, parents in In labels lead from target
+//back to the hub.
+//path - vertices from source to target
+void hubLabelPath(const HubLabels& labels, uint32_t source, uint32_t target, const HubLabelResult& result,
+		std::vector<uint32_t>& path);
+
+#endif /* INC_HUBLABELS_H_ */
@@ -9,13 +9,16 @@
 #define INC_INFORMED_H_
 
 #include <string>
+#include <utility>
+#include <cmath>
+#include <cstdlib>
 #include "graph.h"
 #include "algo.h"
 
 struct Vertex2d : public Vertex {
 	int X;
 	int Y;
-	Vertex2d(string _Name, int _X,  int _Y): Vertex(_Name), X(_X), Y(_Y) {};
+	Vertex2d(string _Name, int _X,  int _Y): Vertex(std::move(_Name)), X(_X), Y(_Y) {};
 	virtual Vertex2d* edgelessClone() override;
 };
 
@@ -27,13 +30,88 @@ struct Vertex2d : public Vertex {
 //Parameters:
 //source - source vertex
 //target - target vertex
+//workspace - per-query state
 //callback - function that is called by algorithm to send events to caller
 //result - result of algorithm execution: Found - path from source to target found or NotFound if no path from source to target was found
 //user_context - pointer to some info - may be needed to understand the origin of event if several algorithm
 //               launches were made simultaneously
 //coefficient - coefficient to use in weight calculation (see formula above)
 //Way to get found path - the same as for Dijkstra.
-void dijkstra2d(Vertex2d* source, Vertex2d* target, Graph& graph, Callback callback,  AlgoResult& result, void* user_context = nullptr, double coefficient = 0.5);
+void dijkstra2d(Vertex2d* source, Vertex2d* target, Graph& graph, QueryWorkspace& workspace, Callback callback,  AlgoResult& result, void* user_context = nullptr, double coefficient = 0.5);
+
+//The same as above but source and target vertices are given by id
+void dijkstra2d(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback,  AlgoResult& result, void* user_context = nullptr, double coefficient = 0.5);
+
+//Heuristics for aStar(). Heuristic estimates weight of the path from vertex to target.
+//Heuristics with UsesCoordinates get the offset (dx, dy) of vertex from target, others get ids of vertex and target.
+//Found path is of minimal weight if heuristic is consistent: estimate at the start of any edge never exceeds
+//weight of the edge plus estimate at its end.
+
+//No guidance, aStar() works as Dijkstra. Can be used with any graph.
+struct ZeroHeuristic {
+	static constexpr bool UsesCoordinates = false;
+	weight_t operator()(vertex_id_t, vertex_id_t) const { return 0; }
+};
+
+//Distance on a grid where moves go along axes only
+struct ManhattanDistance {
+	static double of(int dx, int dy) { return std::abs(dx) + std::abs(dy); }
+};
+
+//Distance on a grid where diagonal moves are allowed
+struct OctileDistance {
+	static double of(int dx, int dy) {
+		double a = std::abs(dx), b = std::abs(dy);
+		return a > b ? a + (M_SQRT2 - 1) * b : b + (M_SQRT2 - 1) * a;
+	}
+};
+
+//Straight line distance
+struct EuclideanDistance {
+	static double of(int dx, int dy) { return std::sqrt(double(dx) * dx + double(dy) * dy); }
+};
+
+//Distance to target multiplied by Scale. Vertices must be Vertex2d.
+//Heuristic is consistent if Scale does not exceed minWeightPerDistance() of the graph.
+template <class Distance>
+struct CoordinateHeuristic {
+	static constexpr bool UsesCoordinates = true;
+	weight_t Scale = 1;
+	weight_t operator()(int dx, int dy) const { return Scale * Distance::of(dx, dy); }
+};
+
+typedef CoordinateHeuristic<ManhattanDistance> ManhattanHeuristic;
+typedef CoordinateHeuristic<OctileDistance> OctileHeuristic;
+typedef CoordinateHeuristic<EuclideanDistance> EuclideanHeuristic;
+
+template <class Distance>
+weight_t minWeightPerDistance(const Graph& graph);
+
+//A* search. Finds the minimum weight path from source to target in a weighted graph with non-negative edge weights.
+//Vertices are processed in order of f = g + h, where g is weight of the path from source (kept in workspace.Forward.Weight)
+//and h is heuristic estimate of the rest of the path (f is kept in workspace.Forward.Estimate).
+//With consistent heuristic every processed vertex has final g, so path weights are exact as in dijkstra(),
+//but fewer vertices are processed the better heuristic estimates the rest of the path.
+//Heuristic is a template parameter so that it is inlined: ZeroHeuristic, ManhattanHeuristic, OctileHeuristic or EuclideanHeuristic.
+//Coordinate heuristics require Vertex2d vertices.
+//Parameters:
+//source - source vertex
+//target - target vertex
+//workspace - per-query state. Radix heap is replaced with 4-ary heap (priorities are not integer).
+//heuristic - heuristic estimate of the path weight from vertex to target
+//callback - function that is called by algorithm to send events to caller
+//result - result of algorithm execution: Found - path from source to target found or NotFound if no path from source to target was found
+//user_context - pointer to some info - may be needed to understand the origin of event if several algorithm
+//               launches were made simultaneously
+//Way to get found path - the same as for Dijkstra.
+template <class Heuristic>
+void aStar(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, const Heuristic& heuristic, Callback callback, AlgoResult& result, void* user_context = nullptr);
+
+//The same as above but source and target vertices are given by id
+template <class Heuristic>
+void aStar(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, const Heuristic& heuristic, Callback callback, AlgoResult& result, void* user_context = nullptr) {
+	aStar(findVertex(source, graph), findVertex(target, graph), graph, workspace, heuristic, callback, result, user_context);
+}
 
 
 #endif /* INC_INFORMED_H_ */
@@ -0,0 +1,56 @@
+/*
+ * johnson.h
+ *
+ *  Johnson's reweighting: vertex potentials that make edge weights non-negative, so Dijkstra-family searches
+ *  work on graphs with negative edges.
+ */
+
+#ifndef INC_JOHNSON_H_
+#define INC_JOHNSON_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csr.h"
+
+//Potential p(v) of every vertex of CsrGraph: weight of the minimal weight path to v from a virtual vertex that has
+//zero weight edges to all vertices, so p(v) <= 0 and p(v) <= p(u) + w for every edge u->v.
+//Reduced weight of edge u->v is w + p(u) - p(v) >= 0. Weight of every path from s to t changes by p(s) - p(t),
+//so minimal weight paths of the reweighted graph are the same as in the original one.
+struct JohnsonPotentials {
+	std::vector<weight_t> Potential;
+
+	uint32_t vertexCount() const { return static_cast<uint32_t>(Potential.size()); }
+	//Weight in the original graph of a path from v to w that has weight reduced_weight in the reweighted graph
+	weight_t originalWeight(uint32_t v, uint32_t w, weight_t reduced_weight) const {
+		return reduced_weight == INFINITE_WEIGHT ? INFINITE_WEIGHT : reduced_weight - Potential[v] + Potential[w];
+	}
+};
+
+//Computes potentials by findNegativeCycle() search started from all vertices at once (as from the virtual vertex).
+//Cost is one Bellman-Ford family search, so compute potentials once and keep them with the graph.
+//graph - graph with original weights
+//potentials - resulting potentials
+//cycle - vertices of a negative loop in path order if there is one: potentials do not exist then
+//Returns false if the graph has a negative loop
+bool computePotentials(const CsrGraph& graph, JohnsonPotentials& potentials, std::vector<uint32_t>& cycle);
+
+//Replaces weights of all edges of the graph (both forward and reverse arrays) with reduced weights.
+//Reduced weights that are negative because of rounding of non-integer weights are set to 0.
+void reweightGraph(CsrGraph& graph, const JohnsonPotentials& potentials);
+
+//Converts weights left in workspace state by a search in the reweighted graph back to the original graph weights.
+//Forward search from source: weight of vertex v gets p(v) - p(source)
+void restoreForwardWeights(const JohnsonPotentials& potentials, uint32_t source, SearchState& state);
+//Backward search to target: weight of vertex v gets p(target) - p(v)
+void restoreBackwardWeights(const JohnsonPotentials& potentials, uint32_t target, SearchState& state);
+
+//Saves potentials of the graph to a binary file. Graph must have original weights.
+//Returns NO_ERROR or an error code (error.h)
+int savePotentials(const JohnsonPotentials& potentials, const CsrGraph& graph, const std::string& path);
+
+//Loads potentials saved by savePotentials(). Graph must have original weights.
+//Returns NO_ERROR, FATAL_ERROR_PREPROCESSED_DATA_MISMATCH if the potentials were computed for another graph or other error code (error.h)
+int loadPotentials(JohnsonPotentials& potentials, const CsrGraph& graph, const std::string& path);
+
+#endif /* INC_JOHNSON_H_ */
@@ -0,0 +1,80 @@
+/*
+ * landmarks.h
+ *
+ *  ALT point-to-point search: A* with lower bounds from distances to landmarks and the triangle inequality.
+ */
+
+#ifndef INC_LANDMARKS_H_
+#define INC_LANDMARKS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csr.h"
+
+//Distances between every vertex of CsrGraph and a few selected vertices (landmarks).
+//Entries of vertex v for landmark k are at position v * landmarkCount() + k, so a bound reads two short contiguous rows.
+struct LandmarkTable {
+	std::vector<uint32_t> Landmarks;      //Vertex indices of landmarks
+	std::vector<weight_t> FromLandmark;   //Weight of minimal weight path from landmark to vertex, INFINITE_WEIGHT if there is no path
+	std::vector<weight_t> ToLandmark;     //Weight of minimal weight path from vertex to landmark, INFINITE_WEIGHT if there is no path
+
+	uint32_t landmarkCount() const { return static_cast<uint32_t>(Landmarks.size()); }
+	uint32_t vertexCount() const { return Landmarks.empty() ? 0 : static_cast<uint32_t>(FromLandmark.size() / Landmarks.size()); }
+
+	//Lower bound of the weight of a path from v to w by triangle inequality:
+	//d(v,w) >= d(L,w) - d(L,v) and d(v,w) >= d(v,L) - d(w,L) for every landmark L. Landmarks without paths are skipped.
+	weight_t lowerBound(uint32_t v, uint32_t w) const {
+		size_t count = Landmarks.size();
+		const weight_t* from_v = FromLandmark.data() + v * count;
+		const weight_t* from_w = FromLandmark.data() + w * count;
+		const weight_t* to_v = ToLandmark.data() + v * count;
+		const weight_t* to_w = ToLandmark.data() + w * count;
+		weight_t bound = 0;
+		for (size_t k = 0; k < count; k++) {
+			if (from_w[k] < INFINITE_WEIGHT && from_v[k] < INFINITE_WEIGHT && from_w[k] - from_v[k] > bound) bound = from_w[k] - from_v[k];
+			if (to_v[k] < INFINITE_WEIGHT && to_w[k] < INFINITE_WEIGHT && to_v[k] - to_w[k] > bound) bound = to_v[k] - to_w[k];
+		}
+		return bound;
+	}
+};
+
+//Landmark preprocessing. Picks landmarks and finds minimal weight paths from and to every landmark.
+//Edge weights must be non-negative.
+//Complexity O(count * (|E| + |V|) * log|V|), memory 16 * count bytes per vertex.
+//graph - graph to preprocess
+//count - number of landmarks (not more than vertex count)
+//selection - the way landmarks are picked
+//table - resulting table
+//Returns false if graph has negative edge weights
+bool selectLandmarks(const CsrGraph& graph, uint32_t count, LandmarkSelection selection, LandmarkTable& table);
+
+//Saves landmark table of the graph to a binary file
+//Returns NO_ERROR or an error code (error.h)
+int saveLandmarks(const LandmarkTable& table, const CsrGraph& graph, const std::string& path);
+
+//Loads landmark table saved by saveLandmarks()
+//Returns NO_ERROR, FATAL_ERROR_PREPROCESSED_DATA_MISMATCH if the table was saved for another graph or other error code (error.h)
+int loadLandmarks(LandmarkTable& table, const CsrGraph& graph, const std::string& path);
+
+//Heuristic of aStar() for CsrGraph: landmark lower bound of the weight of the path from vertex to target.
+//It is consistent, so aStar() with it finds minimal weight paths.
+struct LandmarkHeuristic {
+	static constexpr bool UsesCoordinates = false;
+	const LandmarkTable* Table = nullptr;
+	weight_t operator()(uint32_t v, uint32_t target) const { return Table->lowerBound(v, target); }
+};
+
+//Unidirectional ALT search: aStar() with LandmarkHeuristic. Parameters, events and result are the same as for aStar().
+void altSearch(const CsrGraph& graph, const LandmarkTable& table, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, AlgoResult& result, void* user_context = nullptr);
+
+//Bidirectional ALT search. Forward search from source and backward search from target are A* searches with average
+//potentials p(v) = (lowerBound(v, target) - lowerBound(source, v)) / 2 and -p(v) (Ikeda et al.), which keeps both consistent.
+//Forward and backward steps alternate. Search stops when the sum of queue tops is not less than the best path found.
+//Queue keys (path weight plus potential) are kept in workspace.Forward.Estimate and workspace.Backward.Estimate.
+//Way to get found path - the same as for bidirectionalDijkstra().
+void bidirectionalAlt(const CsrGraph& graph, const LandmarkTable& table, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, CsrBidirectionalResult& result, void* user_context = nullptr);
+
+#endif /* INC_LANDMARKS_H_ */
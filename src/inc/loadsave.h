@@ -10,10 +10,23 @@
 
 #include "graph.h"
 #include "settings.h"
+#include "csr.h"
 
 //Load graph from the file of json format
 int loadGraph(Graph& graph, const Settings& settings);
 
+//Load graph from the file of json format directly into CSR representation
+//Vertex indices are assigned in the order of vertex names.
+int loadCsrGraph(CsrGraph& csr, const Settings& settings);
+
+//Load graph from the file of json format with a streaming (SAX) parser that builds no document.
+//Memory is taken by the graph, vertex names and edges kept until the end of the file (edges may name vertices
+//defined later), the file is read through a fixed-size buffer. The graph is the same as loadGraph() makes.
+int streamGraph(Graph& graph, const Settings& settings);
+
+//Streaming version of loadCsrGraph(), see streamGraph()
+int streamCsrGraph(CsrGraph& csr, const Settings& settings);
+
 //Load graph from the file of 2d format
 int load2dGraph(Graph& graph, const Settings& settings);
 
@@ -0,0 +1,106 @@
+/*
+ * parallel.h
+ *
+ *  Thread pool and parallel algorithms working on CsrGraph.
+ */
+
+#ifndef INC_PARALLEL_H_
+#define INC_PARALLEL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "csr.h"
+
+//Fixed set of worker threads that run loops in parallel. The calling thread takes part in every loop as thread 0.
+//Create it once and pass to every parallel algorithm call: threads are started in constructor only.
+class ThreadPool {
+public:
+	//Loop body: processes items begin..end-1 of the range, thread is the index of the running thread (0..size()-1)
+	typedef std::function<void(size_t begin, size_t end, unsigned thread)> Task;
+
+	//thread_count - number of threads including the calling one. 0 means the number of hardware threads.
+	explicit ThreadPool(unsigned thread_count = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	unsigned size() const { return static_cast<unsigned>(Workers_.size()) + 1; }
+
+	//Runs task on chunks of range 0..count-1 on all threads and returns when the whole range is processed.
+	//Chunks of grain items are handed out dynamically, so uneven items are balanced between threads.
+	void parallelFor(size_t count, const Task& task, size_t grain = 256);
+
+private:
+	std::vector<std::thread> Workers_;
+	std::mutex Mutex_;
+	std::condition_variable Start_;
+	std::condition_variable Finish_;
+	const Task* Task_ = nullptr;
+	size_t Count_ = 0;
+	size_t Grain_ = 1;
+	std::atomic<size_t> Next_{0};
+	unsigned Generation_ = 0;   //Number of loops started, wakes workers up
+	unsigned Running_ = 0;      //Number of workers that have not finished current loop
+	bool Stop_ = false;
+
+	void work(unsigned thread);
+	void runChunks(unsigned thread);
+};
+
+//Parallel delta-stepping single source shortest path search (Meyer, Sanders). Vertices are kept in buckets of width delta
+//by tentative path weight. Buckets are processed in order: edges not heavier than delta (light) of the current bucket
+//are relaxed in parallel until the bucket stays empty, then heavy edges of all vertices removed from the bucket are relaxed
+//in parallel. Edge weights must be non-negative: if there are negative ones, parallelBellmanFord() is run instead
+//(result may be NegativeLoopFound then, events are the ones of parallelBellmanFord()).
+//Path weights are the same as found by dijkstra(). Parents form a tree of minimal-weight paths built from source by
+//breadth-first walk over edges that lie on such paths, so among paths of equal weight another one may be chosen.
+//Sends TargetFound and AlgorithmFinished events only (from the calling thread).
+//graph - graph to search in
+//source - source vertex
+//target - target vertex. Search stops when the path weight to target is final. If target is CSR_NO_VERTEX, paths to all
+//         vertices are found and result is Ok.
+//workspace - per-query state, results are in workspace.Forward (weights and parents of vertices with final path weight)
+//pool - threads to use
+//delta - bucket width. If it is not positive, max edge weight / average out-degree is used.
+//callback, result, user_context - the same as for dijkstra()
+void deltaStepping(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, ThreadPool& pool,
+		weight_t delta, CsrCallback callback, AlgoResult& result, void* user_context = nullptr);
+
+//Parallel Bellman-Ford minimal weight path search (Jacobi-style). Every pass computes new path weights from the weights
+//of the previous pass, which are kept in a separate array: each thread takes a range of vertices and pulls the minimum over
+//their incoming edges, so every vertex is written by one thread only and no atomic operations are needed. Only edges from
+//vertices improved in the previous pass are relaxed. Passes stop when one changes nothing.
+//Negative loops are detected the same way as by bellmanFord(): the graph of parents is checked for a cycle after every pass.
+//Path weights are the same as found by bellmanFord(). Among paths of equal weight the one through the first incoming edge
+//(in the order of CsrGraph::Sources) is chosen, so parents do not depend on the number of threads.
+//Sends NegativeLoopDetected and AlgorithmFinished events only (from the calling thread).
+//graph - graph to search in
+//source - source vertex
+//target - target vertex. It does not stop the search. If target is CSR_NO_VERTEX, result is Ok.
+//workspace - per-query state, results are in workspace.Forward (weights and parents of all vertices)
+//pool - threads to use
+//callback, result, user_context - the same as for bellmanFord()
+void parallelBellmanFord(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, ThreadPool& pool,
+		CsrCallback callback, CsrBellmanFordResult& result, void* user_context = nullptr);
+
+//Parallel level-synchronous breadth-first search. Vertices of each level of the frontier are expanded by all threads,
+//visited vertices are claimed in a shared bitmap with atomic operations, so every vertex gets exactly one parent.
+//Every thread collects the next level in its own buffer, buffers are joined when the level is done.
+//Finds the shortest path in the sense of the minimum number of transitions between vertices.
+//Sends TargetFound, TargetNotFound and AlgorithmFinished events only (from the calling thread).
+//graph - graph to search in
+//source - source vertex
+//target - target vertex. Search stops after the level where target is found. If target is CSR_NO_VERTEX, all vertices
+//         reachable from source are labeled and result is Ok.
+//workspace - per-query state, results are in workspace.Forward: parent and number of transitions from source (as weight)
+//pool - threads to use
+//callback, result, user_context - the same as for bfs()
+void parallelBfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, ThreadPool& pool,
+		CsrCallback callback, AlgoResult& result, void* user_context = nullptr);
+
+#endif /* INC_PARALLEL_H_ */
@@ -0,0 +1,51 @@
+/*
+ * pathtree.h
+ *
+ *  Output of minimal weight paths from source to all vertices: one pass over the tree of parents kept in SearchState.
+ */
+
+#ifndef INC_PATHTREE_H_
+#define INC_PATHTREE_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "workspace.h"
+
+//Collects output in a fixed-size buffer and passes it to the stream in large blocks instead of a stream call per item
+class BufferedWriter {
+public:
+	explicit BufferedWriter(std::ostream& out, size_t capacity = 1 << 16);
+	~BufferedWriter() { flush(); }
+	BufferedWriter(const BufferedWriter&) = delete;
+	BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+	void write(const char* data, size_t size);
+	void write(const std::string& s) { write(s.data(), s.size()); }
+	void write(const char* s);
+	//Writes weight the way std::ostream does by default (6 significant digits)
+	void write(weight_t weight);
+	void flush();
+private:
+	std::ostream& Out_;
+	std::vector<char> Buffer_;
+	size_t Size_ = 0;
+};
+
+//Writes paths from source to all vertices found by a single-source search: weights and parents in state must form a tree.
+//Full format, a line per vertex: "V0->V2->V5 weight: 14" or "V1: no path from source to this vertex".
+//    Lines follow depth-first order of the tree (children in the order of vertices), the path to a vertex extends the path
+//    to its parent kept in a buffer, so no parent chains are walked. Vertices without path follow the tree.
+//Compact format (compact = true), a line per vertex in the order of vertices: "V5 V2 14" - vertex, parent, weight,
+//    "-" for no parent or no path. Size of the output is linear in the number of vertices.
+//out - stream to write to
+//source - source vertex of the search
+//state - result of the search
+//order - vertices in the order they are written
+//names - name of every vertex, indexed by vertex id
+//compact - format of the output
+void writePathTree(std::ostream& out, uint32_t source, const SearchState& state, const std::vector<uint32_t>& order,
+		const std::vector<const std::string*>& names, bool compact);
+
+#endif /* INC_PATHTREE_H_ */
@@ -0,0 +1,174 @@
+/*
+ * queue.h
+ *
+ *  Priority queues of vertex ids used by Dijkstra-family searches.
+ */
+
+#ifndef INC_QUEUE_H_
+#define INC_QUEUE_H_
+
+#include <vector>
+#include <cstdint>
+#include <boost/heap/binomial_heap.hpp>
+#include <boost/heap/pairing_heap.hpp>
+#include "types.h"
+
+//All queues below share the same interface:
+//    reset(weights, vertex_count) - empties the queue before a query. Keys of vertices are read from weights[vertex].
+//    empty(), top(), pop()        - the usual ones. top() is the vertex with minimal key.
+//    push(v)                      - inserts vertex v, which must not be in the queue
+//    decrease(v)                  - restores order after key of vertex v (which is in the queue) was decreased
+//Per-vertex data of a queue is kept between queries and reallocated only when the graph grows.
+
+//Compare functor for priority queue of vertex ids ordered by weights stored in an array
+struct VertexWeightComparator {
+	const weight_t *Weights = nullptr;
+	VertexWeightComparator() {};
+	VertexWeightComparator(const weight_t *weights): Weights(weights) {};
+	bool operator()(const vertex_id_t& v1, const vertex_id_t& v2) const {
+		return Weights[v1] > Weights[v2];
+		// return "true" if "v1" is ordered before "v2"
+	}
+};
+
+//Adapter of boost mutable heaps
+template <class Heap>
+class BoostHeapQueue {
+public:
+	void reset(const weight_t* weights, vertex_id_t vertex_count) {
+		Heap_ = Heap(VertexWeightComparator(weights));
+		if (Handle_.size() < vertex_count) Handle_.resize(vertex_count);
+	}
+	bool empty() const { return Heap_.empty(); }
+	vertex_id_t top() const { return Heap_.top(); }
+	void pop() { Heap_.pop(); }
+	void push(vertex_id_t v) { Handle_[v] = Heap_.push(v); }
+	void decrease(vertex_id_t v) { Heap_.increase(Handle_[v], v); }
+private:
+	Heap Heap_;
+	std::vector<typename Heap::handle_type> Handle_;
+};
+
+typedef BoostHeapQueue<boost::heap::binomial_heap<vertex_id_t, boost::heap::compare<VertexWeightComparator>>> BinomialQueue;
+typedef BoostHeapQueue<boost::heap::pairing_heap<vertex_id_t, boost::heap::compare<VertexWeightComparator>>> PairingQueue;
+
+//Indexed d-ary heap stored in a flat array. Position_ keeps the place of every vertex in the array, so decrease-key is a sift-up.
+template <unsigned Arity>
+class DaryHeapQueue {
+public:
+	void reset(const weight_t* weights, vertex_id_t vertex_count) {
+		Weights_ = weights;
+		Heap_.clear();
+		if (Position_.size() < vertex_count) Position_.resize(vertex_count);
+	}
+	bool empty() const { return Heap_.empty(); }
+	vertex_id_t top() const { return Heap_.front(); }
+	void pop() {
+		vertex_id_t last = Heap_.back();
+		Heap_.pop_back();
+		if (!Heap_.empty()) siftDown(0, last);
+	}
+	void push(vertex_id_t v) {
+		Heap_.push_back(v);
+		siftUp(static_cast<uint32_t>(Heap_.size() - 1), v);
+	}
+	void decrease(vertex_id_t v) { siftUp(Position_[v], v); }
+private:
+	const weight_t* Weights_ = nullptr;
+	std::vector<vertex_id_t> Heap_;
+	std::vector<uint32_t> Position_;
+
+	//Moves vertex v up starting from position i (the hole)
+	void siftUp(uint32_t i, vertex_id_t v) {
+		weight_t w = Weights_[v];
+		while (i > 0) {
+			uint32_t parent = (i - 1) / Arity;
+			vertex_id_t p = Heap_[parent];
+			if (Weights_[p] <= w) break;
+			Heap_[i] = p;
+			Position_[p] = i;
+			i = parent;
+		}
+		Heap_[i] = v;
+		Position_[v] = i;
+	}
+
+	//Moves vertex v down starting from position i (the hole)
+	void siftDown(uint32_t i, vertex_id_t v) {
+		weight_t w = Weights_[v];
+		uint32_t size = static_cast<uint32_t>(Heap_.size());
+		for (;;) {
+			uint32_t first = i * Arity + 1;
+			if (first >= size) break;
+			uint32_t last = first + Arity < size ? first + Arity : size;
+			uint32_t best = first;
+			for (uint32_t c = first + 1; c < last; c++) {
+				if (Weights_[Heap_[c]] < Weights_[Heap_[best]]) best = c;
+			}
+			if (Weights_[Heap_[best]] >= w) break;
+			Heap_[i] = Heap_[best];
+			Position_[Heap_[i]] = i;
+			i = best;
+		}
+		Heap_[i] = v;
+		Position_[v] = i;
+	}
+};
+
+typedef DaryHeapQueue<2> BinaryHeapQueue;
+typedef DaryHeapQueue<4> QuaternaryHeapQueue;
+
+//Monotone radix heap for non-negative integer keys: extracted keys never decrease, which holds for Dijkstra search
+//with non-negative integer edge weights. Entry with key k goes to bucket number of the highest bit in which k differs
+//from the last extracted key, so every entry moves to lower buckets at most 64 times.
+//Decrease-key pushes another entry; outdated entries (key differs from current weight of the vertex) are skipped on extraction.
+//Vertices of INFINITE_WEIGHT are kept apart and extracted after all others.
+class RadixQueue {
+public:
+	void reset(const weight_t* weights, vertex_id_t vertex_count);
+	bool empty() const { return Size_ == 0; }
+	vertex_id_t top();
+	void pop();
+	void push(vertex_id_t v);
+	void decrease(vertex_id_t v);
+private:
+	struct Entry {
+		uint64_t Key;
+		vertex_id_t Vertex;
+	};
+	static constexpr int BUCKET_COUNT = 65;
+	const weight_t* Weights_ = nullptr;
+	std::vector<Entry> Buckets_[BUCKET_COUNT];
+	std::vector<vertex_id_t> Infinite_;
+	uint64_t Last_ = 0;
+	uint32_t Size_ = 0;    //number of vertices in the queue (outdated entries are not counted)
+
+	void insert(uint64_t key, vertex_id_t v);
+	bool isActual(const Entry& e) const { return Weights_[e.Vertex] == static_cast<weight_t>(e.Key); }
+};
+
+//Dial's bucket queue for non-negative integer keys. Keys of vertices in the queue never differ from the last extracted
+//key by more than maximal edge weight C, so C+1 buckets used as a circular array are enough: vertex with key k is
+//in bucket k mod (C+1). Push and decrease-key are O(1), extraction scans buckets without comparisons.
+//Decrease-key and outdated entries are handled in the same way as in RadixQueue.
+class DialQueue {
+public:
+	//Sets maximal edge weight of the graph. Should be called before reset().
+	void setMaxWeight(uint32_t max_weight) { Buckets_.resize(max_weight + 1); }
+	void reset(const weight_t* weights, vertex_id_t vertex_count);
+	bool empty() const { return Size_ == 0; }
+	vertex_id_t top();
+	void pop();
+	void push(vertex_id_t v);
+	void decrease(vertex_id_t v);
+private:
+	const weight_t* Weights_ = nullptr;
+	std::vector<std::vector<vertex_id_t>> Buckets_;
+	std::vector<vertex_id_t> Infinite_;
+	uint64_t Current_ = 0;  //key of the current bucket
+	uint32_t Size_ = 0;     //number of vertices in the queue (outdated entries are not counted)
+
+	std::vector<vertex_id_t>& bucket(weight_t key) { return Buckets_[static_cast<uint64_t>(key) % Buckets_.size()]; }
+};
+
+#endif /* INC_QUEUE_H_ */
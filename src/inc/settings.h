@@ -2,10 +2,17 @@
 #define __SETTINGS_H_
 
 #include <string>
+#include <map>
 #include "types.h"
 
 using namespace std;
 
+//Upper bound of the number of threads of parallel algorithms
+constexpr int MAX_THREADS = 1024;
+
+//Human readable names of algorithms
+extern map <Algorithm, string> AlgorithmNames;
+
 struct Settings {
 	Algorithm SearchAlgorithm = Algorithm::None;
 	int VertexCount = 6;
@@ -22,6 +29,22 @@ struct Settings {
 	string TargetVertex = "";
 	bool LoadFromFile = false;
 	bool SaveToFile = false;
+	bool UseCsr = false;
+	bool LazyQueue = false;
+	QueueType Queue = QueueType::Binomial;
+	int BenchmarkQueries = 0;
+	double Delta = 0;        //Bucket width of delta-stepping, 0 means automatic choice
+	int Threads = 0;         //Number of threads of parallel algorithms, 0 means the number of hardware threads
+	HeuristicType Heuristic = HeuristicType::Auto;   //Heuristic of A* search
+	int LandmarkCount = 16;                          //Number of landmarks of ALT search
+	LandmarkSelection Landmarks = LandmarkSelection::Avoid;
+	bool Preprocess = false;   //Run preprocessing of the algorithm and save its result next to the graph file
+	bool Reweight = false;     //Run search on the graph reweighted with Johnson's potentials
+	ApspMethod Apsp = ApspMethod::Auto;   //Method of all-pairs search
+	string MatrixFile = "";    //Binary file for the distance matrix, the matrix is printed if it is empty
+	string QueryFile = "";     //File with sources and targets of many-to-many distance matrix query
+	bool CompactPaths = false; //Print paths to all vertices as "vertex parent weight" lines instead of whole paths
+	bool StreamJson = false;   //Load json graph with the streaming (SAX) parser instead of a document
 	GraphType TypeOfGraph = GraphType::GraphNonpositional;
 
 	int parse (int argc, char **argv);
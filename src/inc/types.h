@@ -9,9 +9,11 @@
 #define INC_TYPES_H_
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
-#include <boost/heap/binomial_heap.hpp>
+#include <unordered_map>
+#include <cstdint>
 
 #define INFINITE_WEIGHT 1E30
 
@@ -23,6 +25,19 @@ enum class Algorithm {
 	FastDijkstra,
 	BellmanFord,
 	Dijkstra2D,
+	DialDijkstra,
+	DeltaStepping,
+	DirectionOptimizingBfs,
+	ParallelBfs,
+	BidirectionalBfs,
+	AStar,
+	Alt,
+	BidirectionalAlt,
+	ContractionHierarchies,
+	HubLabels,
+	Spfa,
+	ParallelBellmanFord,
+	AllPairs,
 };
 
 enum class AlgoEvent {
@@ -49,6 +64,36 @@ enum class GraphType {
 	Graph2D
 };
 
+//Kinds of priority queue Dijkstra-family searches can use (see queue.h)
+enum class QueueType {
+	Binomial,   //boost::heap::binomial_heap (default)
+	DaryHeap,   //Indexed 4-ary heap over a flat array
+	Pairing,    //boost::heap::pairing_heap
+	Radix       //Monotone radix heap. Requires non-negative integer edge weights and no heuristic.
+};
+
+//Heuristics of A* search (see informed.h)
+enum class HeuristicType {
+	Auto,       //Manhattan for 2d graphs, zero otherwise
+	Zero,
+	Manhattan,
+	Octile,
+	Euclidean
+};
+
+//The way landmarks of ALT search are picked (see landmarks.h)
+enum class LandmarkSelection {
+	Farthest,   //Every next landmark is the vertex farthest from the ones already picked
+	Avoid       //Goldberg-Werneck "avoid": leaf of the shortest path tree of a random vertex in the region worst covered by picked landmarks
+};
+
+//The way all-pairs search finds weights
+enum class ApspMethod {
+	Auto,            //Picked by graph density
+	FloydWarshall,   //Blocked Floyd-Warshall over the dense matrix: O(|V|^3), does not depend on edge count
+	Dijkstra         //Dijkstra search from every vertex: O(|V| * |E| * log|V|), better for sparse graphs
+};
+
 struct AlgoResult {
 	AlgoResultCode ResultCode = AlgoResultCode::NotFound;
 	std::string getText();
@@ -58,8 +103,12 @@ struct Edge;
 
 typedef std::vector<Edge*> EdgeList;
 
+typedef uint32_t vertex_id_t;
+constexpr vertex_id_t NO_VERTEX_ID = UINT32_MAX;
+
 struct Vertex {
 	std::string Name;
+	vertex_id_t Id = NO_VERTEX_ID;  //Dense vertex id assigned when vertex is added to a graph
 	EdgeList *OutcomingEdges = nullptr;
 	EdgeList *IncomingEdges = nullptr;
 	void* Context = nullptr;
@@ -81,26 +130,30 @@ struct Edge {
 
 typedef Edge* PEdge;
 
-typedef std::map<std::string, Vertex*> Graph;
-
-struct DijkstraContext;
-
-struct DijkstraVertexComparator {  //Compare functor that is used in Dijkstra algorithm
-    bool operator()(const PVertex& v1, const PVertex& v2) const;
+//Graph is a set of vertices ordered by name.
+//Every vertex added to the graph gets a dense id (0, 1, 2...) that is never reused,
+//so per-vertex data of algorithms can be kept in arrays indexed by vertex id.
+//Iteration over the graph goes over (name, vertex) pairs in the order of names.
+//Vertex::Name is the only copy of the name: keys of the name tables are views of it,
+//so the name of a vertex must not be changed while the vertex is in the graph.
+struct Graph {
+	typedef std::map<std::string_view, Vertex*> VertexMap;
+	VertexMap Vertices;                                           //Vertices ordered by name
+	std::unordered_map<std::string_view, vertex_id_t> NameIds;    //Interning table: vertex name to vertex id
+	std::vector<Vertex*> VerticesById;                       //Vertex id to vertex (nullptr for removed vertices)
+
+	VertexMap::iterator begin() { return Vertices.begin(); }
+	VertexMap::iterator end() { return Vertices.end(); }
+	VertexMap::const_iterator begin() const { return Vertices.begin(); }
+	VertexMap::const_iterator end() const { return Vertices.end(); }
+	VertexMap::size_type size() const { return Vertices.size(); }
+	bool empty() const { return Vertices.empty(); }
+	//Upper bound of vertex ids: size of arrays indexed by vertex id
+	vertex_id_t idCount() const { return static_cast<vertex_id_t>(VerticesById.size()); }
+	//Name of the vertex with given id
+	const std::string& name(vertex_id_t id) const { return VerticesById[id]->Name; }
 };
 
-struct FastDijkstraForwardComparator { //Compare functor that is used in bidirectional Dijkstra algorithm in forward search
-    bool operator()(const PVertex& v1, const PVertex& v2) const;
-};
-
-struct FastDijkstraBackwardComparator { //Compare functor that is used in bidirectional Dijkstra algorithm in backward search
-    bool operator()(const PVertex& v1, const PVertex& v2) const;
-};
-
-typedef boost::heap::detail::node_handle<boost::heap::detail::parent_pointing_heap_node<PVertex>*, boost::heap::detail::make_binomial_heap_base<PVertex, boost::parameter::aux::flat_like_arg_list<boost::parameter::aux::flat_like_arg_tuple<boost::heap::tag::compare, boost::heap::compare<DijkstraVertexComparator>, std::integral_constant<bool, true> > > >::type, PVertex&> VertexHandle;
-typedef boost::heap::detail::node_handle<boost::heap::detail::parent_pointing_heap_node<PVertex>*, boost::heap::detail::make_binomial_heap_base<PVertex, boost::parameter::aux::flat_like_arg_list<boost::parameter::aux::flat_like_arg_tuple<boost::heap::tag::compare, boost::heap::compare<FastDijkstraForwardComparator>, std::integral_constant<bool, true> > > >::type, PVertex&> ForwardSearchVertexHandle;
-typedef boost::heap::detail::node_handle<boost::heap::detail::parent_pointing_heap_node<PVertex>*, boost::heap::detail::make_binomial_heap_base<PVertex, boost::parameter::aux::flat_like_arg_list<boost::parameter::aux::flat_like_arg_tuple<boost::heap::tag::compare, boost::heap::compare<FastDijkstraBackwardComparator>, std::integral_constant<bool, true> > > >::type, PVertex&> BackwardSearchVertexHandle;
-
 typedef double weight_t;
 
 
@@ -113,23 +166,8 @@ struct BidirectionalDijkstraResult : AlgoResult{
 	}
 };
 
-struct DijkstraContext {   //Vertex additional information for Dijkstra algorithm.
-	weight_t Weight = INFINITE_WEIGHT;  //Weight of the minimal-weight path from source to that vertex
-	Vertex* Parent = nullptr;           //Previous vertex in the minimal-weight path from source to that vertex
-	VertexHandle Handle;                //Handle of the vertex to be used in priority queue (benomial heap)
-	bool Processed = false;             //Vertex processing completion mark
-};
-
-struct BidirectionalDijkstraContext { //Vertex additional information for bidirectional Dijkstra algorithm.
-	weight_t WeightInForwardSearch = INFINITE_WEIGHT;  //Weight of the minimal-weight path from source to that vertex
-	Vertex* ParentInForwardSearch = nullptr;           //Previous vertex in the minimal-weight path from source to that vertex
-	ForwardSearchVertexHandle HandleInForwardSearch;   //Handle of the vertex to be used in forward search priority queue (benomial heap)
-	bool ProcessedByForwardSearch = false; 			   //Vertex forward search processing completion mark
-	weight_t WeightInBackwardSearch = INFINITE_WEIGHT; //Weight of the minimal-weight path from target to that vertex
-	Vertex* ParentInBackwardSearch = nullptr;          //Previous vertex in the minimal-weight path from target to that vertex
-	BackwardSearchVertexHandle HandleInBackwardSearch; //Handle of the vertex to be used in backward search priority queue (benomial heap)
-	bool ProcessedByBackwardSearch = false;            //Vertex backward search processing completion mark
-	BidirectionalDijkstraContext(){};
+struct BellmanFordResult : AlgoResult {
+	std::vector<Vertex*> NegativeCycle;   //Vertices of the negative loop in path order if result is NegativeLoopFound
 };
 
 //Callback prototype
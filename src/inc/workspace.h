@@ -0,0 +1,142 @@
+/*
+ * workspace.h
+ *
+ *  Per-query state of shortest path algorithms kept in arrays indexed by vertex id.
+ */
+
+#ifndef INC_WORKSPACE_H_
+#define INC_WORKSPACE_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "types.h"
+#include "queue.h"
+
+//The way vertices get into the priority queue of Dijkstra-family searches
+enum class QueueInsertion {
+	Eager,  //All vertices are pushed before the search starts (with INFINITE_WEIGHT except source)
+	Lazy    //Vertex is pushed when it is reached first time, so a query costs time proportional to the explored region
+};
+
+//Per-vertex state of one search direction in struct-of-arrays form. All arrays are indexed by vertex id.
+//Entries of a vertex are valid only if Stamp of the vertex equals Epoch, i.e. the vertex was touched by current query.
+//Untouched vertex has INFINITE_WEIGHT, no parent and is not processed. Use weight(), parent() and processed() to read
+//the state from outside of algorithms.
+struct SearchState {
+	std::vector<weight_t> Weight;      //Weight of the minimal-weight path from source (from vertex to target in backward search)
+	std::vector<vertex_id_t> Parent;   //Previous vertex in the path from source (next vertex in the path to target in backward search)
+	std::vector<char> Processed;       //Vertex processing completion mark
+	std::vector<uint32_t> Stamp;       //Epoch of the last query that touched the vertex
+	uint32_t Epoch = 0;                //Epoch of current query
+	std::vector<weight_t> Estimate;    //Weight plus heuristic estimate of the rest of the path: priority of A* search.
+	                                   //Allocated by A* search only, valid for touched vertices.
+
+	//Priority queues of the search direction. Only the one selected by QueryWorkspace::Queue is used.
+	BinomialQueue Binomial;
+	QuaternaryHeapQueue DaryHeap;
+	PairingQueue Pairing;
+	RadixQueue Radix;
+	//Queues of Dial's algorithm (see dialDijkstra())
+	DialQueue Dial;
+	BinaryHeapQueue BinaryHeap;
+
+	//Prepares the state for a new query in O(1): starts new epoch so that all vertices become untouched.
+	//vertex_count - upper bound of vertex ids (Graph::idCount() or CsrGraph::vertexCount())
+	//Memory is allocated only when the graph has grown since the previous query.
+	void reset(vertex_id_t vertex_count);
+
+	//Initializes entries of the vertex for current query if it is not done yet. Must be called before the first access to arrays.
+	void touch(vertex_id_t v) {
+		if (Stamp[v] != Epoch) {
+			Stamp[v] = Epoch;
+			Weight[v] = INFINITE_WEIGHT;
+			Parent[v] = NO_VERTEX_ID;
+			Processed[v] = false;
+		}
+	}
+
+	//Allocates Estimate array for searches that use it. Must be called after reset().
+	void allocateEstimate() {
+		if (Estimate.size() < Weight.size()) Estimate.resize(Weight.size());
+	}
+
+	//The same as touch() for searches that use Estimate: it is initialized with INFINITE_WEIGHT too
+	void touchWithEstimate(vertex_id_t v) {
+		if (Stamp[v] != Epoch) {
+			touch(v);
+			Estimate[v] = INFINITE_WEIGHT;
+		}
+	}
+
+	bool touched(vertex_id_t v) const { return Stamp[v] == Epoch; }
+	weight_t weight(vertex_id_t v) const { return touched(v) ? Weight[v] : INFINITE_WEIGHT; }
+	vertex_id_t parent(vertex_id_t v) const { return touched(v) ? Parent[v] : NO_VERTEX_ID; }
+	bool processed(vertex_id_t v) const { return touched(v) && Processed[v]; }
+};
+
+//State of parallel searches (deltaStepping(), parallelBfs()) shared by their threads, kept between queries like SearchState.
+//Between queries Weight is INFINITE_WEIGHT and Visited bits are clear for all vertices: a query restores the entries it
+//changed, so the arrays are neither allocated nor cleared per query. Marks are compared with counters that only grow,
+//so they are never cleared either.
+struct ParallelSearchState {
+	std::unique_ptr<std::atomic<weight_t>[]> Weight;    //Tentative path weights of delta-stepping
+	std::unique_ptr<std::atomic<uint64_t>[]> Visited;   //Bitmap of vertices visited by parallel breadth-first search
+	std::vector<uint64_t> Reached;     //Query the vertex got a finite weight in (value of Query)
+	std::vector<uint64_t> RoundMark;   //Light edge round the vertex was relaxed in last (value of Round)
+	std::vector<uint64_t> RemovedMark; //Bucket the vertex was removed from last (value of Bucket)
+	uint64_t Query = 0;
+	uint64_t Round = 0;
+	uint64_t Bucket = 0;
+	vertex_id_t VertexCount = 0;       //Size of the arrays
+
+	//Prepares the state for a new query. Memory is allocated only when the graph has grown since the previous query.
+	void reset(vertex_id_t vertex_count);
+};
+
+//Reusable state of searches. Create it once and pass to every query:
+//it replaces per-vertex context objects that were allocated and freed on each run.
+//Results of the last query stay in the workspace until the next query.
+struct QueryWorkspace {
+	SearchState Forward;    //State of the search from source
+	SearchState Backward;   //State of the search from target (used by bidirectional algorithms only)
+	ParallelSearchState Parallel;   //Shared state of parallel searches
+	QueueInsertion Insertion = QueueInsertion::Eager;  //Priority queue insertion mode of Dijkstra-family searches
+	QueueType Queue = QueueType::Binomial;             //Priority queue of Dijkstra-family searches
+};
+
+//Restores order of the queue after weight of vertex v was decreased from old_weight.
+//In lazy insertion mode the vertex that had INFINITE_WEIGHT is not in the queue yet, so it is pushed.
+template <class Queue>
+inline void updateQueue(Queue& queue, vertex_id_t v, weight_t old_weight, QueueInsertion insertion) {
+	if (insertion == QueueInsertion::Lazy && old_weight == INFINITE_WEIGHT) {
+		queue.push(v);
+	}
+	else {
+		queue.decrease(v);
+	}
+}
+
+//Calls search(forward_queue, backward_queue) with the queues of the type selected in workspace.
+//monotone - false if keys extracted from the queue can be non-integer or decreasing (searches with heuristic),
+//           radix heap is replaced with d-ary heap then.
+template <class Search>
+inline void withSelectedQueue(QueryWorkspace& workspace, bool monotone, Search search) {
+	switch (workspace.Queue) {
+	case QueueType::DaryHeap:
+		search(workspace.Forward.DaryHeap, workspace.Backward.DaryHeap);
+		break;
+	case QueueType::Pairing:
+		search(workspace.Forward.Pairing, workspace.Backward.Pairing);
+		break;
+	case QueueType::Radix:
+		if (monotone) search(workspace.Forward.Radix, workspace.Backward.Radix);
+		else search(workspace.Forward.DaryHeap, workspace.Backward.DaryHeap);
+		break;
+	default:
+		search(workspace.Forward.Binomial, workspace.Backward.Binomial);
+		break;
+	}
+}
+
+#endif /* INC_WORKSPACE_H_ */
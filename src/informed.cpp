@@ -16,7 +16,8 @@
 };
 
 
-void dijkstra2d(Vertex2d* source, Vertex2d* target, Graph& graph, Callback callback, AlgoResult& result, void* user_context, double coefficient) {
+template <class Queue>
+static void dijkstra2dSearch(Vertex2d* source, Vertex2d* target, Graph& graph, QueryWorkspace& workspace, Queue& queue, Callback callback, AlgoResult& result, void* user_context, double coefficient) {
 	if (!source || !target) {
 		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
 		return;
@@ -26,26 +27,30 @@ void dijkstra2d(Vertex2d* source, Vertex2d* target, Graph& graph, Callback callb
 		result.ResultCode = AlgoResultCode::SourceIsTarget;
 		return;
 	};
-	boost::heap::binomial_heap<PVertex, boost::heap::compare<DijkstraVertexComparator>> queue;
 	int x_target = target->X, y_target = target->Y;
-	DijkstraContext *current_context;
-	for (const auto& pair : graph) {
-		current_context = new DijkstraContext();
-		Vertex* v = pair.second;
-		if (v == source) {
-			current_context->Weight = 0;
+	SearchState& state = workspace.Forward;
+	state.reset(graph.idCount());
+	state.touch(source->Id);
+	state.Weight[source->Id] = 0;
+
+	queue.reset(state.Weight.data(), graph.idCount());
+	if (workspace.Insertion == QueueInsertion::Lazy) {
+		queue.push(source->Id);
+	}
+	else {
+		for (const auto& pair : graph) {
+			state.touch(pair.second->Id);
+			queue.push(pair.second->Id);
 		}
-		v->Context = current_context;
-		current_context->Handle = queue.push(v);
 	}
 
 	while (!queue.empty()) {
-		Vertex2d* v_current = static_cast<Vertex2d*>(queue.top());
+		vertex_id_t current_id = queue.top();
+		Vertex2d* v_current = static_cast<Vertex2d*>(graph.VerticesById[current_id]);
 		queue.pop();
 		weight_t current_coef = abs(v_current->X - x_target) + abs(v_current->Y - y_target);
-		current_context = static_cast<DijkstraContext*>(v_current->Context);
 		//Dead end
-		if (current_context->Weight == INFINITE_WEIGHT) {
+		if (state.Weight[current_id] == INFINITE_WEIGHT) {
 			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
 			result.ResultCode = AlgoResultCode::NotFound;
 			return;
@@ -53,19 +58,20 @@ void dijkstra2d(Vertex2d* source, Vertex2d* target, Graph& graph, Callback callb
 		if (callback) callback(AlgoEvent::VertexProcessingStarted, v_current, user_context);
 		for (const auto &e : *(v_current->OutcomingEdges)) {
 			Vertex2d *v_to = static_cast<Vertex2d*>(e->ToVertex);
-			DijkstraContext *v_to_context = static_cast<DijkstraContext*>(v_to->Context);
-			if (v_to_context->Processed) continue;
+			state.touch(v_to->Id);
+			if (state.Processed[v_to->Id]) continue;
 			if (callback) callback(AlgoEvent::VertexDiscovered, v_to, user_context);
 			weight_t to_coef = abs(v_to->X - x_target) + abs(v_to->Y - y_target);
-			weight_t to_weight_to_be = current_context->Weight + e->Weight + (to_coef - current_coef)*coefficient;
-			if (v_to_context->Weight > to_weight_to_be) {
-				v_to_context->Weight = to_weight_to_be;
-				v_to_context->Parent = static_cast<Vertex*>(v_current);
+			weight_t to_weight_to_be = state.Weight[current_id] + e->Weight + (to_coef - current_coef)*coefficient;
+			weight_t old_weight = state.Weight[v_to->Id];
+			if (old_weight > to_weight_to_be) {
+				state.Weight[v_to->Id] = to_weight_to_be;
+				state.Parent[v_to->Id] = current_id;
 
-				queue.increase(static_cast<VertexHandle>(v_to_context->Handle), e->ToVertex);
+				updateQueue(queue, v_to->Id, old_weight, workspace.Insertion);
 			}
 		}
-		current_context->Processed = true;
+		state.Processed[current_id] = true;
 		if (callback) callback(AlgoEvent::VertexProcessingFinished, v_current, user_context);
 
 		if (v_current == target) {
@@ -80,4 +86,123 @@ void dijkstra2d(Vertex2d* source, Vertex2d* target, Graph& graph, Callback callb
 	result.ResultCode = AlgoResultCode::NotFound;
 }
 
+void dijkstra2d(Vertex2d* source, Vertex2d* target, Graph& graph, QueryWorkspace& workspace, Callback callback, AlgoResult& result, void* user_context, double coefficient) {
+	withSelectedQueue(workspace, false, [&](auto& queue, auto&) {
+		dijkstra2dSearch(source, target, graph, workspace, queue, callback, result, user_context, coefficient);
+	});
+}
+
+void dijkstra2d(vertex_id_t source, vertex_id_t target, Graph& graph, QueryWorkspace& workspace, Callback callback, AlgoResult& result, void* user_context, double coefficient) {
+	dijkstra2d(static_cast<Vertex2d*>(findVertex(source, graph)), static_cast<Vertex2d*>(findVertex(target, graph)),
+			graph, workspace, callback, result, user_context, coefficient);
+}
+
+template <class Distance>
+weight_t minWeightPerDistance(const Graph& graph) {
+	weight_t scale = INFINITE_WEIGHT;
+	for (const auto& pair : graph) {
+		const Vertex2d* from = static_cast<const Vertex2d*>(pair.second);
+		for (const auto& e : *(from->OutcomingEdges)) {
+			if (e->Weight < 0) return 0;
+			const Vertex2d* to = static_cast<const Vertex2d*>(e->ToVertex);
+			double distance = Distance::of(to->X - from->X, to->Y - from->Y);
+			if (distance > 0 && e->Weight / distance < scale) scale = e->Weight / distance;
+		}
+	}
+	return scale == INFINITE_WEIGHT ? 0 : scale;
+}
+
+template weight_t minWeightPerDistance<ManhattanDistance>(const Graph& graph);
+template weight_t minWeightPerDistance<OctileDistance>(const Graph& graph);
+template weight_t minWeightPerDistance<EuclideanDistance>(const Graph& graph);
+
+//Heuristic estimate of the path weight from v to target
+template <class Heuristic>
+static inline weight_t estimate(const Heuristic& heuristic, const Vertex* v, const Vertex* target) {
+	if constexpr (Heuristic::UsesCoordinates) {
+		const Vertex2d* v2d = static_cast<const Vertex2d*>(v);
+		const Vertex2d* target2d = static_cast<const Vertex2d*>(target);
+		return heuristic(v2d->X - target2d->X, v2d->Y - target2d->Y);
+	}
+	else {
+		return heuristic(v->Id, target->Id);
+	}
+}
+
+template <class Queue, class Heuristic>
+static void aStarSearch(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, Queue& queue, const Heuristic& heuristic, Callback callback, AlgoResult& result, void* user_context) {
+	if (!source || !target) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	};
+
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	};
+	SearchState& state = workspace.Forward;
+	state.reset(graph.idCount());
+	state.allocateEstimate();
+	state.touchWithEstimate(source->Id);
+	state.Weight[source->Id] = 0;
+	state.Estimate[source->Id] = estimate(heuristic, source, target);
+
+	queue.reset(state.Estimate.data(), graph.idCount());
+	if (workspace.Insertion == QueueInsertion::Lazy) {
+		queue.push(source->Id);
+	}
+	else {
+		for (const auto& pair : graph) {
+			state.touchWithEstimate(pair.second->Id);
+			queue.push(pair.second->Id);
+		}
+	}
+
+	while (!queue.empty()) {
+		vertex_id_t current_id = queue.top();
+		Vertex* v_current = graph.VerticesById[current_id];
+		queue.pop();
+		//Dead end
+		if (state.Estimate[current_id] == INFINITE_WEIGHT) break;
+
+		if (callback) callback(AlgoEvent::VertexProcessingStarted, v_current, user_context);
+		for (const auto &e : *(v_current->OutcomingEdges)) {
+			Vertex* v_to = e->ToVertex;
+			state.touchWithEstimate(v_to->Id);
+			if (state.Processed[v_to->Id]) continue;
+			if (callback) callback(AlgoEvent::VertexDiscovered, v_to, user_context);
+			weight_t to_weight_to_be = state.Weight[current_id] + e->Weight;
+			if (state.Weight[v_to->Id] > to_weight_to_be) {
+				weight_t old_estimate = state.Estimate[v_to->Id];
+				state.Weight[v_to->Id] = to_weight_to_be;
+				state.Estimate[v_to->Id] = to_weight_to_be + estimate(heuristic, v_to, target);
+				state.Parent[v_to->Id] = current_id;
+				updateQueue(queue, v_to->Id, old_estimate, workspace.Insertion);
+			}
+		}
+		state.Processed[current_id] = true;
+		if (callback) callback(AlgoEvent::VertexProcessingFinished, v_current, user_context);
+
+		if (v_current == target) {
+			if (callback) callback(AlgoEvent::TargetFound, v_current, user_context);
+			result.ResultCode = AlgoResultCode::Found;
+			if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
+			return;
+		}
+	};
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, nullptr, user_context);
+	result.ResultCode = AlgoResultCode::NotFound;
+}
+
+template <class Heuristic>
+void aStar(Vertex* source, Vertex* target, Graph& graph, QueryWorkspace& workspace, const Heuristic& heuristic, Callback callback, AlgoResult& result, void* user_context) {
+	withSelectedQueue(workspace, false, [&](auto& queue, auto&) {
+		aStarSearch(source, target, graph, workspace, queue, heuristic, callback, result, user_context);
+	});
+}
 
+template void aStar<ZeroHeuristic>(Vertex*, Vertex*, Graph&, QueryWorkspace&, const ZeroHeuristic&, Callback, AlgoResult&, void*);
+template void aStar<ManhattanHeuristic>(Vertex*, Vertex*, Graph&, QueryWorkspace&, const ManhattanHeuristic&, Callback, AlgoResult&, void*);
+template void aStar<OctileHeuristic>(Vertex*, Vertex*, Graph&, QueryWorkspace&, const OctileHeuristic&, Callback, AlgoResult&, void*);
+template void aStar<EuclideanHeuristic>(Vertex*, Vertex*, Graph&, QueryWorkspace&, const EuclideanHeuristic&, Callback, AlgoResult&, void*);
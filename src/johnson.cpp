@@ -0,0 +1,82 @@
+/*
+ * johnson.cpp
+ *
+ *  Johnson's reweighting: vertex potentials that make edge weights non-negative, so Dijkstra-family searches
+ *  work on graphs with negative edges.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include "johnson.h"
+#include "error.h"
+
+bool computePotentials(const CsrGraph& graph, JohnsonPotentials& potentials, std::vector<uint32_t>& cycle) {
+	QueryWorkspace workspace;
+	potentials.Potential.clear();
+	if (findNegativeCycle(graph, CSR_NO_VERTEX, workspace, cycle)) return false;
+	uint32_t vertex_count = graph.vertexCount();
+	potentials.Potential.resize(vertex_count);
+	for (uint32_t v = 0; v < vertex_count; v++) {
+		potentials.Potential[v] = workspace.Forward.weight(v);
+	}
+	return true;
+}
+
+void reweightGraph(CsrGraph& graph, const JohnsonPotentials& potentials) {
+	const std::vector<weight_t>& p = potentials.Potential;
+	for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+		for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+			graph.Weights[j] = std::max<weight_t>(0, graph.Weights[j] + p[v] - p[graph.Targets[j]]);
+		}
+		for (uint32_t j = graph.ReverseOffsets[v]; j < graph.ReverseOffsets[v + 1]; j++) {
+			graph.ReverseWeights[j] = std::max<weight_t>(0, graph.ReverseWeights[j] + p[graph.Sources[j]] - p[v]);
+		}
+	}
+}
+
+void restoreForwardWeights(const JohnsonPotentials& potentials, uint32_t source, SearchState& state) {
+	for (uint32_t v = 0; v < potentials.vertexCount(); v++) {
+		if (state.weight(v) < INFINITE_WEIGHT) state.Weight[v] = potentials.originalWeight(source, v, state.Weight[v]);
+	}
+}
+
+void restoreBackwardWeights(const JohnsonPotentials& potentials, uint32_t target, SearchState& state) {
+	for (uint32_t v = 0; v < potentials.vertexCount(); v++) {
+		if (state.weight(v) < INFINITE_WEIGHT) state.Weight[v] = potentials.originalWeight(v, target, state.Weight[v]);
+	}
+}
+
+//Potentials file: signature, graph fingerprint, vertex count, potentials
+static const char POTENTIALS_FILE_SIGNATURE[8] = {'G', 'C', 'J', 'P', 'v', '1', 0, 0};
+
+int savePotentials(const JohnsonPotentials& potentials, const CsrGraph& graph, const std::string& path) {
+	std::ofstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	uint64_t fingerprint = graphFingerprint(graph);
+	uint32_t vertex_count = potentials.vertexCount();
+	file.write(POTENTIALS_FILE_SIGNATURE, sizeof(POTENTIALS_FILE_SIGNATURE));
+	file.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+	file.write(reinterpret_cast<const char*>(&vertex_count), sizeof(vertex_count));
+	file.write(reinterpret_cast<const char*>(potentials.Potential.data()), potentials.Potential.size() * sizeof(weight_t));
+	return file ? NO_ERROR : FATAL_ERROR_FILE_WRITE_FAILURE;
+}
+
+int loadPotentials(JohnsonPotentials& potentials, const CsrGraph& graph, const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	char signature[sizeof(POTENTIALS_FILE_SIGNATURE)];
+	uint64_t fingerprint = 0;
+	uint32_t vertex_count = 0;
+	file.read(signature, sizeof(signature));
+	file.read(reinterpret_cast<char*>(&fingerprint), sizeof(fingerprint));
+	file.read(reinterpret_cast<char*>(&vertex_count), sizeof(vertex_count));
+	if (!file || !std::equal(signature, signature + sizeof(signature), POTENTIALS_FILE_SIGNATURE)) return FATAL_ERROR_FILE_READ_FAILURE;
+	if (vertex_count != graph.vertexCount() || fingerprint != graphFingerprint(graph)) return FATAL_ERROR_PREPROCESSED_DATA_MISMATCH;
+	potentials.Potential.resize(vertex_count);
+	file.read(reinterpret_cast<char*>(potentials.Potential.data()), potentials.Potential.size() * sizeof(weight_t));
+	if (!file) {
+		potentials = JohnsonPotentials();
+		return FATAL_ERROR_FILE_READ_FAILURE;
+	}
+	return NO_ERROR;
+}
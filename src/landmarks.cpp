@@ -0,0 +1,331 @@
+/*
+ * landmarks.cpp
+ *
+ *  ALT point-to-point search: A* with lower bounds from distances to landmarks and the triangle inequality.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <random>
+#include "landmarks.h"
+#include "error.h"
+
+//Finds weights of minimal weight paths from source to all vertices (from all vertices to source if reverse is true)
+//weight - resulting weights, INFINITE_WEIGHT if there is no path
+//parent - previous vertex in the path from source, CSR_NO_VERTEX for source and unreachable vertices (optional)
+//order - reachable vertices in the order their weights became final (optional)
+static void shortestPathTree(const CsrGraph& graph, uint32_t source, bool reverse, std::vector<weight_t>& weight,
+		std::vector<uint32_t>* parent = nullptr, std::vector<uint32_t>* order = nullptr) {
+	const std::vector<uint32_t>& offsets = reverse ? graph.ReverseOffsets : graph.Offsets;
+	const std::vector<uint32_t>& heads = reverse ? graph.Sources : graph.Targets;
+	const std::vector<weight_t>& weights = reverse ? graph.ReverseWeights : graph.Weights;
+	weight.assign(graph.vertexCount(), INFINITE_WEIGHT);
+	if (parent) parent->assign(graph.vertexCount(), CSR_NO_VERTEX);
+	if (order) order->clear();
+
+	typedef std::pair<weight_t, uint32_t> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	weight[source] = 0;
+	queue.push(Entry(0, source));
+	while (!queue.empty()) {
+		Entry top = queue.top();
+		queue.pop();
+		uint32_t v = top.second;
+		//Outdated entry: weight of the vertex was decreased after it was pushed
+		if (top.first > weight[v]) continue;
+		if (order) order->push_back(v);
+		for (uint32_t i = offsets[v]; i < offsets[v + 1]; i++) {
+			uint32_t to = heads[i];
+			if (weight[to] > weight[v] + weights[i]) {
+				weight[to] = weight[v] + weights[i];
+				if (parent) (*parent)[to] = v;
+				queue.push(Entry(weight[to], to));
+			}
+		}
+	}
+}
+
+//Landmark tables while landmarks are being selected: one array per landmark
+struct LandmarkColumns {
+	std::vector<uint32_t> Landmarks;
+	std::vector<std::vector<weight_t>> FromLandmark;
+	std::vector<std::vector<weight_t>> ToLandmark;
+
+	//The same as LandmarkTable::lowerBound()
+	weight_t lowerBound(uint32_t v, uint32_t w) const {
+		weight_t bound = 0;
+		for (size_t k = 0; k < Landmarks.size(); k++) {
+			const std::vector<weight_t>& from = FromLandmark[k];
+			const std::vector<weight_t>& to = ToLandmark[k];
+			if (from[w] < INFINITE_WEIGHT && from[v] < INFINITE_WEIGHT && from[w] - from[v] > bound) bound = from[w] - from[v];
+			if (to[v] < INFINITE_WEIGHT && to[w] < INFINITE_WEIGHT && to[v] - to[w] > bound) bound = to[v] - to[w];
+		}
+		return bound;
+	}
+};
+
+//Vertex farthest from the landmarks picked (farthest from start if there are no landmarks yet).
+//Vertices unreachable from landmarks are the farthest ones.
+static uint32_t farthestVertex(const CsrGraph& graph, const LandmarkColumns& columns, uint32_t start) {
+	std::vector<weight_t> start_weight;
+	if (columns.Landmarks.empty()) shortestPathTree(graph, start, false, start_weight);
+	uint32_t farthest = CSR_NO_VERTEX;
+	weight_t farthest_weight = -1;
+	for (uint32_t v = 0; v < graph.vertexCount(); v++) {
+		weight_t weight = INFINITE_WEIGHT;
+		if (columns.Landmarks.empty()) {
+			weight = start_weight[v];
+		}
+		else {
+			for (const auto& from : columns.FromLandmark) weight = std::min(weight, from[v]);
+		}
+		if (weight > farthest_weight && std::find(columns.Landmarks.begin(), columns.Landmarks.end(), v) == columns.Landmarks.end()) {
+			farthest = v;
+			farthest_weight = weight;
+		}
+	}
+	return farthest;
+}
+
+//Goldberg-Werneck "avoid" selection. Builds the minimal weight path tree of root. Size of a vertex is the sum over its
+//subtree of the difference between path weight from root and its landmark lower bound, 0 if the subtree has a landmark.
+//The search goes from the vertex of maximal size down to the child of maximal size, the leaf reached is the new landmark.
+//Returns CSR_NO_VERTEX if the tree is covered by landmarks.
+static uint32_t avoidVertex(const CsrGraph& graph, const LandmarkColumns& columns, uint32_t root) {
+	uint32_t vertex_count = graph.vertexCount();
+	std::vector<weight_t> weight;
+	std::vector<uint32_t> parent, order;
+	shortestPathTree(graph, root, false, weight, &parent, &order);
+
+	std::vector<weight_t> size(vertex_count, 0);
+	std::vector<char> covered(vertex_count, false);
+	for (uint32_t landmark : columns.Landmarks) covered[landmark] = true;
+	//Children go after their parents in order
+	for (size_t i = order.size(); i-- > 0;) {
+		uint32_t v = order[i];
+		if (covered[v]) size[v] = 0;
+		else size[v] += weight[v] - columns.lowerBound(root, v);
+		uint32_t p = parent[v];
+		if (p == CSR_NO_VERTEX) continue;
+		if (covered[v]) covered[p] = true;
+		else size[p] += size[v];
+	}
+
+	uint32_t best = CSR_NO_VERTEX;
+	for (uint32_t v : order) {
+		if (size[v] > 0 && (best == CSR_NO_VERTEX || size[v] > size[best])) best = v;
+	}
+	if (best == CSR_NO_VERTEX) return CSR_NO_VERTEX;
+
+	//Tree children in first child - next sibling form
+	std::vector<uint32_t> first_child(vertex_count, CSR_NO_VERTEX), next_sibling(vertex_count, CSR_NO_VERTEX);
+	for (uint32_t v : order) {
+		uint32_t p = parent[v];
+		if (p == CSR_NO_VERTEX) continue;
+		next_sibling[v] = first_child[p];
+		first_child[p] = v;
+	}
+	while (first_child[best] != CSR_NO_VERTEX) {
+		uint32_t next = first_child[best];
+		for (uint32_t child = next_sibling[next]; child != CSR_NO_VERTEX; child = next_sibling[child]) {
+			if (size[child] > size[next]) next = child;
+		}
+		best = next;
+	}
+	return best;
+}
+
+bool selectLandmarks(const CsrGraph& graph, uint32_t count, LandmarkSelection selection, LandmarkTable& table) {
+	table = LandmarkTable();
+	for (weight_t w : graph.Weights) {
+		if (w < 0) return false;
+	}
+	uint32_t vertex_count = graph.vertexCount();
+	count = std::min(count, vertex_count);
+
+	//Fixed seed: the same graph gets the same landmarks
+	std::mt19937 random(997);
+	LandmarkColumns columns;
+	for (uint32_t k = 0; k < count; k++) {
+		uint32_t start = random() % vertex_count;
+		uint32_t landmark = CSR_NO_VERTEX;
+		if (selection == LandmarkSelection::Avoid) landmark = avoidVertex(graph, columns, start);
+		if (landmark == CSR_NO_VERTEX) landmark = farthestVertex(graph, columns, start);
+		columns.Landmarks.push_back(landmark);
+		columns.FromLandmark.emplace_back();
+		columns.ToLandmark.emplace_back();
+		shortestPathTree(graph, landmark, false, columns.FromLandmark.back());
+		shortestPathTree(graph, landmark, true, columns.ToLandmark.back());
+	}
+
+	table.Landmarks = columns.Landmarks;
+	table.FromLandmark.resize(size_t(vertex_count) * count);
+	table.ToLandmark.resize(size_t(vertex_count) * count);
+	for (uint32_t v = 0; v < vertex_count; v++) {
+		for (uint32_t k = 0; k < count; k++) {
+			table.FromLandmark[size_t(v) * count + k] = columns.FromLandmark[k][v];
+			table.ToLandmark[size_t(v) * count + k] = columns.ToLandmark[k][v];
+		}
+	}
+	return true;
+}
+
+//Landmark file: signature, graph fingerprint, vertex count, landmark count, landmarks, FromLandmark, ToLandmark
+static const char LANDMARK_FILE_SIGNATURE[8] = {'G', 'C', 'A', 'L', 'T', 'v', '1', 0};
+
+int saveLandmarks(const LandmarkTable& table, const CsrGraph& graph, const std::string& path) {
+	std::ofstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	uint64_t fingerprint = graphFingerprint(graph);
+	uint32_t vertex_count = graph.vertexCount(), landmark_count = table.landmarkCount();
+	file.write(LANDMARK_FILE_SIGNATURE, sizeof(LANDMARK_FILE_SIGNATURE));
+	file.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+	file.write(reinterpret_cast<const char*>(&vertex_count), sizeof(vertex_count));
+	file.write(reinterpret_cast<const char*>(&landmark_count), sizeof(landmark_count));
+	file.write(reinterpret_cast<const char*>(table.Landmarks.data()), table.Landmarks.size() * sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(table.FromLandmark.data()), table.FromLandmark.size() * sizeof(weight_t));
+	file.write(reinterpret_cast<const char*>(table.ToLandmark.data()), table.ToLandmark.size() * sizeof(weight_t));
+	return file ? NO_ERROR : FATAL_ERROR_FILE_WRITE_FAILURE;
+}
+
+int loadLandmarks(LandmarkTable& table, const CsrGraph& graph, const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) return FATAL_ERROR_FILE_OPEN_FAILURE;
+	char signature[sizeof(LANDMARK_FILE_SIGNATURE)];
+	uint64_t fingerprint = 0;
+	uint32_t vertex_count = 0, landmark_count = 0;
+	file.read(signature, sizeof(signature));
+	file.read(reinterpret_cast<char*>(&fingerprint), sizeof(fingerprint));
+	file.read(reinterpret_cast<char*>(&vertex_count), sizeof(vertex_count));
+	file.read(reinterpret_cast<char*>(&landmark_count), sizeof(landmark_count));
+	if (!file || !std::equal(signature, signature + sizeof(signature), LANDMARK_FILE_SIGNATURE)) return FATAL_ERROR_FILE_READ_FAILURE;
+	if (vertex_count != graph.vertexCount() || fingerprint != graphFingerprint(graph) || landmark_count > vertex_count) {
+		return FATAL_ERROR_PREPROCESSED_DATA_MISMATCH;
+	}
+	table.Landmarks.resize(landmark_count);
+	table.FromLandmark.resize(size_t(vertex_count) * landmark_count);
+	table.ToLandmark.resize(size_t(vertex_count) * landmark_count);
+	file.read(reinterpret_cast<char*>(table.Landmarks.data()), table.Landmarks.size() * sizeof(uint32_t));
+	file.read(reinterpret_cast<char*>(table.FromLandmark.data()), table.FromLandmark.size() * sizeof(weight_t));
+	file.read(reinterpret_cast<char*>(table.ToLandmark.data()), table.ToLandmark.size() * sizeof(weight_t));
+	if (!file) {
+		table = LandmarkTable();
+		return FATAL_ERROR_FILE_READ_FAILURE;
+	}
+	return NO_ERROR;
+}
+
+void altSearch(const CsrGraph& graph, const LandmarkTable& table, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, AlgoResult& result, void* user_context) {
+	if (table.vertexCount() != graph.vertexCount()) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	aStar(graph, source, target, workspace, LandmarkHeuristic{&table}, callback, result, user_context);
+}
+
+template <class Queue>
+static void bidirectionalAltSearch(const CsrGraph& graph, const LandmarkTable& table, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		Queue& forward_queue, Queue& backward_queue, CsrCallback callback, CsrBidirectionalResult& result, void* user_context) {
+	uint32_t vertex_count = graph.vertexCount();
+	if (source >= vertex_count || target >= vertex_count || table.vertexCount() != vertex_count) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	}
+	//Potential of forward search, backward search uses -potential(v)
+	auto potential = [&](uint32_t v) {
+		return (table.lowerBound(v, target) - table.lowerBound(source, v)) / 2;
+	};
+	SearchState& forward = workspace.Forward;
+	SearchState& backward = workspace.Backward;
+	forward.reset(vertex_count);
+	backward.reset(vertex_count);
+	forward.allocateEstimate();
+	backward.allocateEstimate();
+	forward.touchWithEstimate(source);
+	backward.touchWithEstimate(target);
+	forward.Weight[source] = 0;
+	backward.Weight[target] = 0;
+	forward.Estimate[source] = potential(source);
+	backward.Estimate[target] = -potential(target);
+	result.ResultCode = AlgoResultCode::NotFound;
+
+	forward_queue.reset(forward.Estimate.data(), vertex_count);
+	backward_queue.reset(backward.Estimate.data(), vertex_count);
+	if (workspace.Insertion == QueueInsertion::Lazy) {
+		forward_queue.push(source);
+		backward_queue.push(target);
+	}
+	else {
+		for (uint32_t v = 0; v < vertex_count; v++) {
+			forward.touchWithEstimate(v);
+			backward.touchWithEstimate(v);
+			forward_queue.push(v);
+			backward_queue.push(v);
+		}
+	}
+
+	weight_t shortest_path_weight = INFINITE_WEIGHT;
+	bool forward_step = true;
+	while (!forward_queue.empty() && !backward_queue.empty()) {
+		weight_t forward_key = forward.Estimate[forward_queue.top()];
+		weight_t backward_key = backward.Estimate[backward_queue.top()];
+		//Dead end: all vertices reachable from source (or reaching target) are processed
+		if (forward_key == INFINITE_WEIGHT || backward_key == INFINITE_WEIGHT) break;
+		//No path through unprocessed vertices can be shorter than the one found
+		if (shortest_path_weight <= forward_key + backward_key) break;
+
+		SearchState& state = forward_step ? forward : backward;
+		SearchState& other = forward_step ? backward : forward;
+		Queue& queue = forward_step ? forward_queue : backward_queue;
+		const std::vector<uint32_t>& offsets = forward_step ? graph.Offsets : graph.ReverseOffsets;
+		const std::vector<uint32_t>& heads = forward_step ? graph.Targets : graph.Sources;
+		const std::vector<weight_t>& weights = forward_step ? graph.Weights : graph.ReverseWeights;
+
+		uint32_t current = queue.top();
+		queue.pop();
+		if (callback) callback(AlgoEvent::VertexProcessingStarted, current, user_context);
+		for (uint32_t i = offsets[current]; i < offsets[current + 1]; i++) {
+			uint32_t neighbor = heads[i];
+			state.touchWithEstimate(neighbor);
+			if (state.Processed[neighbor]) continue;
+			if (callback) callback(AlgoEvent::VertexDiscovered, neighbor, user_context);
+
+			weight_t new_weight = state.Weight[current] + weights[i];
+			if (state.Weight[neighbor] > new_weight) {
+				weight_t old_estimate = state.Estimate[neighbor];
+				state.Weight[neighbor] = new_weight;
+				state.Estimate[neighbor] = new_weight + (forward_step ? potential(neighbor) : -potential(neighbor));
+				state.Parent[neighbor] = current;
+				updateQueue(queue, neighbor, old_estimate, workspace.Insertion);
+			}
+
+			//Neighbor is reached by the other search: a path from source to target is found
+			if (other.weight(neighbor) < INFINITE_WEIGHT && new_weight + other.Weight[neighbor] < shortest_path_weight) {
+				shortest_path_weight = new_weight + other.Weight[neighbor];
+				result.ForwardSearchLastVertex = forward_step ? current : neighbor;
+				result.BackwardSearchLastVertex = forward_step ? neighbor : current;
+				result.ConnectingEdgeWeight = weights[i];
+			}
+		}
+		state.Processed[current] = true;
+		if (callback) callback(AlgoEvent::VertexProcessingFinished, current, user_context);
+		forward_step = !forward_step;
+	}
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+	if (shortest_path_weight < INFINITE_WEIGHT) result.ResultCode = AlgoResultCode::Found;
+}
+
+void bidirectionalAlt(const CsrGraph& graph, const LandmarkTable& table, uint32_t source, uint32_t target, QueryWorkspace& workspace,
+		CsrCallback callback, CsrBidirectionalResult& result, void* user_context) {
+	withSelectedQueue(workspace, false, [&](auto& forward_queue, auto& backward_queue) {
+		bidirectionalAltSearch(graph, table, source, target, workspace, forward_queue, backward_queue, callback, result, user_context);
+	});
+}
@@ -8,7 +8,18 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include "rapidjson/document.h"
+#include "rapidjson/reader.h"
+#include "rapidjson/filereadstream.h"
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/rapidjson.h"
@@ -16,10 +27,10 @@
 #include "graph.h"
 #include "settings.h"
 #include "informed.h"
+#include "csr.h"
 
-int loadGraph(Graph& graph, const Settings& settings) {
-	using namespace std;
-
+//Reads the whole file into a zero-terminated buffer allocated with malloc
+static int readFile(const Settings& settings, char** buffer_out) {
 	FILE * fd = fopen(settings.FilePath.c_str(), "rb");
 
 	if (!fd){
@@ -57,38 +68,125 @@ int loadGraph(Graph& graph, const Settings& settings) {
 	if (settings.Verbose) puts(buffer);
 
 	fclose (fd);
+	*buffer_out = buffer;
+	return NO_ERROR;
+}
+
+//Zero-terminated writable text of a json file, so it can be parsed in situ. Strings of the parsed document point into it.
+class JsonText {
+public:
+	JsonText() = default;
+	~JsonText();
+	JsonText(const JsonText&) = delete;
+	JsonText& operator=(const JsonText&) = delete;
+
+	//Maps the file copy-on-write (private mapping): in situ parsing changes private copies of the pages it writes to, the file
+	//stays intact and pages that are only read are never copied. The mapping is one byte longer than the file and that byte
+	//is zero: it lies either in the zero-filled tail of the last file page or in the anonymous page under the mapping.
+	//Falls back to readFile() where mmap is not available.
+	//Returns NO_ERROR or an error code (error.h)
+	int open(const Settings& settings);
+	char* data() const { return Data_; }
+private:
+	char* Data_ = nullptr;
+	size_t Size_ = 0;
+	bool Mapped_ = false;   //Data_ is a mapping, otherwise it is allocated with malloc
+};
+
+JsonText::~JsonText() {
+#ifndef _WIN32
+	if (Mapped_) {
+		munmap(Data_, Size_ + 1);
+		return;
+	}
+#endif
+	free(Data_);
+}
+
+int JsonText::open(const Settings& settings) {
+#ifndef _WIN32
+	int fd = ::open(settings.FilePath.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return FATAL_ERROR_FILE_OPEN_FAILURE;
+	}
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+		size_t size = static_cast<size_t>(file_stat.st_size);
+		void* area = mmap(nullptr, size + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (area != MAP_FAILED) {
+			if (mmap(area, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) != MAP_FAILED) {
+				::close(fd);
+				Data_ = static_cast<char*>(area);
+				Size_ = size;
+				Mapped_ = true;
+				if (settings.Verbose) puts(Data_);
+				return NO_ERROR;
+			}
+			munmap(area, size + 1);
+		}
+	}
+	::close(fd);
+#endif
+	return readFile(settings, &Data_);
+}
+
+//Name kept in the parsed json text
+static std::string_view jsonName(const rapidjson::Value& value) {
+	return std::string_view(value.GetString(), value.GetStringLength());
+}
+
+static std::string_view nameOf(std::string_view name) { return name; }
+static std::string_view nameOf(const std::pair<std::string_view, Vertex*>& entry) { return entry.first; }
+
+//Binary search of name among entries sorted by name (first of the pair or the entry itself)
+//Returns end if there is no such name
+template<typename Iterator>
+static Iterator findName(Iterator begin, Iterator end, std::string_view name) {
+	auto found = std::lower_bound(begin, end, name, [](const auto& entry, std::string_view key) { return nameOf(entry) < key; });
+	return (found != end && nameOf(*found) == name) ? found : end;
+}
+
+int loadGraph(Graph& graph, const Settings& settings) {
+	using namespace std;
+
+	JsonText text;
+	int err = text.open(settings);
+	if (err != NO_ERROR) {
+		return err;
+	}
 
 	rapidjson::Document doc;
-	doc.ParseInsitu(buffer);
+	doc.ParseInsitu(text.data());
 	if (!doc.IsArray()) {
-		free (buffer);
 		return FATAL_ERROR_FILE_READ_FAILURE;
 	}
 
+	//vertices sorted by name: names are views into the parsed text, so edges are resolved without making strings
+	vector<pair<string_view, Vertex*>> vertices;
+	vertices.reserve(doc.Size());
+
 	//creating all vertices
 	for (rapidjson::Value::ConstValueIterator itr = doc.Begin(); itr != doc.End(); ++itr) {
 	    auto vertex_obj1 = itr->GetObject();
 		if (!vertex_obj1.HasMember("name")) {
-			free (buffer);
 			return FATAL_ERROR_NAME_ELEMENT_NOT_FOUND;
 		}
-		string *str1 = new string (vertex_obj1["name"].GetString());
-
-		Vertex *vertex = addVertex(*str1, graph, settings);
-		if (vertex == nullptr) {
-			free (buffer);
+		string_view name = jsonName(vertex_obj1["name"]);
+		//the vertex name is the only string made of the json name
+		Vertex *vertex = new Vertex(string(name));
+		if (!addVertex(vertex, graph, settings)) {
+			delete vertex;
 			return FATAL_ERROR_FAILED_TO_ADD_VERTEX;
 		}
+		vertices.emplace_back(name, vertex);
 	}
+	sort(vertices.begin(), vertices.end());
 
 	//creating edges
 	for (rapidjson::Value::ConstValueIterator itv = doc.Begin(); itv != doc.End(); ++itv) {
 	    auto vertex_obj2 = itv->GetObject();
-	    string *str_from = new string (vertex_obj2["name"].GetString());
-	    Vertex* from_vertex = findVertex(*str_from, graph);
-
-	    if (!from_vertex) {
-	    	free (buffer);
+	    auto from_vertex = findName(vertices.begin(), vertices.end(), jsonName(vertex_obj2["name"]));
+	    if (from_vertex == vertices.end()) {
 			return FATAL_ERROR_FROM_VERTEX_NOT_FOUND;
 	    }
 
@@ -96,24 +194,336 @@ int loadGraph(Graph& graph, const Settings& settings) {
 			auto edges = vertex_obj2["edges"].GetArray();
 			for (rapidjson::Value::ConstValueIterator ite = edges.Begin(); ite != edges.End(); ++ite) {
 				auto edge_obj = ite->GetObject();
-				string *str_to = new string(edge_obj["to_vertex"].GetString());
-				Vertex* to_vertex = findVertex(*str_to, graph);
-			    if (!to_vertex) {
-			    	free (buffer);
+				auto to_vertex = findName(vertices.begin(), vertices.end(), jsonName(edge_obj["to_vertex"]));
+			    if (to_vertex == vertices.end()) {
 			    	return FATAL_ERROR_TO_VERTEX_NOT_FOUND;
 			    }
 				double weight = edge_obj["weight"].GetDouble();
-				if (!addEdge(from_vertex, to_vertex, weight, graph, settings)) {
-					free (buffer);
+				if (!addEdge(from_vertex->second, to_vertex->second, weight, graph, settings)) {
 					return FATAL_ERROR_FAILED_TO_ADD_EDGE;
 				}
 			}
 		}
 	}
-	free (buffer);
 	return NO_ERROR;
 }
 
+//The same restrictions as addEdge() applies to a single edge
+static bool csrEdgeAllowed(uint32_t from, uint32_t to, double weight, const Settings& settings) {
+	return (from != to || settings.SelfLoop) &&
+			((settings.MinEdgeWeight == 0.0 && settings.MaxEdgeWeight == 0.0)
+			|| (weight >= settings.MinEdgeWeight && weight <= settings.MaxEdgeWeight));
+}
+
+//Builds CSR arrays of the loaded graph and checks restrictions of addEdge() that need the whole graph
+//Returns NO_ERROR or an error code (error.h)
+static int finishCsrGraph(const std::vector<CsrEdge>& edges, CsrGraph& csr, const Settings& settings) {
+	buildCsrGraph(edges, csr);
+
+	if (!settings.BiDirectional) {
+		for (uint32_t v = 0; v < csr.vertexCount(); v++) {
+			for (uint32_t i = csr.Offsets[v]; i < csr.Offsets[v + 1]; i++) {
+				uint32_t to = csr.Targets[i];
+				for (uint32_t j = csr.Offsets[to]; j < csr.Offsets[to + 1]; j++) {
+					if (csr.Targets[j] == v && to != v) return FATAL_ERROR_FAILED_TO_ADD_EDGE;
+				}
+			}
+		}
+	}
+	return NO_ERROR;
+}
+
+int loadCsrGraph(CsrGraph& csr, const Settings& settings) {
+	using namespace std;
+
+	JsonText text;
+	int err = text.open(settings);
+	if (err != NO_ERROR) {
+		return err;
+	}
+
+	rapidjson::Document doc;
+	doc.ParseInsitu(text.data());
+	if (!doc.IsArray()) {
+		return FATAL_ERROR_FILE_READ_FAILURE;
+	}
+
+	//collecting vertex names, indices are assigned in the order of names (the same order Graph iterates vertices).
+	//Names are sorted and searched as views into the parsed text, strings are made once per vertex for csr.Names.
+	vector<string_view> names;
+	names.reserve(doc.Size());
+	for (rapidjson::Value::ConstValueIterator itr = doc.Begin(); itr != doc.End(); ++itr) {
+		auto vertex_obj1 = itr->GetObject();
+		if (!vertex_obj1.HasMember("name")) {
+			return FATAL_ERROR_NAME_ELEMENT_NOT_FOUND;
+		}
+		names.push_back(jsonName(vertex_obj1["name"]));
+	}
+	sort(names.begin(), names.end());
+	csr = CsrGraph();
+	csr.Names.reserve(names.size());
+	for (uint32_t i = 0; i < names.size(); i++) {
+		if (i > 0 && names[i] == names[i - 1]) {
+			return FATAL_ERROR_FAILED_TO_ADD_VERTEX;
+		}
+		csr.Names.emplace_back(names[i]);
+	}
+
+	//collecting edges in the order of the file
+	vector<CsrEdge> edges;
+	for (rapidjson::Value::ConstValueIterator itv = doc.Begin(); itv != doc.End(); ++itv) {
+		auto vertex_obj2 = itv->GetObject();
+		uint32_t from_vertex = static_cast<uint32_t>(findName(names.begin(), names.end(), jsonName(vertex_obj2["name"])) - names.begin());
+		if (!vertex_obj2.HasMember("edges")) continue;
+
+		auto json_edges = vertex_obj2["edges"].GetArray();
+		for (rapidjson::Value::ConstValueIterator ite = json_edges.Begin(); ite != json_edges.End(); ++ite) {
+			auto edge_obj = ite->GetObject();
+			auto found = findName(names.begin(), names.end(), jsonName(edge_obj["to_vertex"]));
+			if (found == names.end()) {
+				return FATAL_ERROR_TO_VERTEX_NOT_FOUND;
+			}
+			uint32_t to_vertex = static_cast<uint32_t>(found - names.begin());
+			double weight = edge_obj["weight"].GetDouble();
+			if (!csrEdgeAllowed(from_vertex, to_vertex, weight, settings)) {
+				return FATAL_ERROR_FAILED_TO_ADD_EDGE;
+			}
+			edges.push_back(CsrEdge{from_vertex, to_vertex, weight});
+		}
+	}
+
+	return finishCsrGraph(edges, csr, settings);
+}
+
+//SAX handler of a json graph file: [{"name": "V0", "edges": [{"to_vertex": "V1", "weight": 1.0}, ...]}, ...]
+//Keeps no document: vertices are collected as they come and every name is interned, so an edge waits for the end of
+//the file as three numbers (vertex it goes from, number of the target name, weight). Names of edge targets may come
+//before the vertices they name; they are resolved when the whole file is read.
+//Members of other names are skipped. Any event out of the format stops parsing.
+class GraphStreamHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, GraphStreamHandler> {
+public:
+	//Edge of the file
+	struct PendingEdge {
+		uint32_t From;      //Number of the vertex (order of the file)
+		uint32_t To;        //Number of the target name
+		weight_t Weight;
+	};
+
+	std::vector<const std::string*> Names;   //Interned names by number (order of first appearance)
+	std::vector<uint32_t> VertexOfName;      //Number of the vertex of each name, CSR_NO_VERTEX if no vertex has it (yet)
+	std::vector<uint32_t> VertexNames;       //Name number of each vertex, CSR_NO_VERTEX until its name comes
+	std::vector<PendingEdge> Edges;          //Edges in the order of the file
+	int Error = NO_ERROR;                    //Error code (error.h) of the event that stopped parsing
+
+	bool StartArray() {
+		if (skipStart()) return true;
+		if (Depth_ == 0) Depth_ = 1;
+		else if (Depth_ == 2 && Field_ == Field::Edges) Depth_ = 3;
+		else return false;
+		Field_ = Field::None;
+		return true;
+	}
+	bool EndArray(rapidjson::SizeType) {
+		if (skipEnd()) return true;
+		Depth_--;
+		return true;
+	}
+	bool StartObject() {
+		if (skipStart()) return true;
+		if (Depth_ == 1) {
+			VertexNames.push_back(CSR_NO_VERTEX);
+		}
+		else if (Depth_ == 3) {
+			HasTarget_ = false;
+			HasWeight_ = false;
+		}
+		else {
+			return false;
+		}
+		Depth_++;
+		return true;
+	}
+	bool Key(const char* str, rapidjson::SizeType length, bool) {
+		if (Skip_ > 0) return true;
+		std::string_view key(str, length);
+		if (Depth_ == 2) Field_ = key == "name" ? Field::Name : key == "edges" ? Field::Edges : Field::Other;
+		else Field_ = key == "to_vertex" ? Field::ToVertex : key == "weight" ? Field::Weight : Field::Other;
+		return true;
+	}
+	bool EndObject(rapidjson::SizeType) {
+		if (skipEnd()) return true;
+		if (Depth_ == 4) {
+			if (!HasTarget_ || !HasWeight_) return fail(FATAL_ERROR_FILE_READ_FAILURE);
+			Edges.push_back(PendingEdge{static_cast<uint32_t>(VertexNames.size() - 1), Target_, Weight_});
+		}
+		else if (VertexNames.back() == CSR_NO_VERTEX) {
+			return fail(FATAL_ERROR_NAME_ELEMENT_NOT_FOUND);
+		}
+		Depth_--;
+		return true;
+	}
+	bool String(const char* str, rapidjson::SizeType length, bool) {
+		if (skipValue()) return true;
+		if (Depth_ == 2 && Field_ == Field::Name) {
+			uint32_t name = intern(str, length);
+			if (VertexOfName[name] != CSR_NO_VERTEX || VertexNames.back() != CSR_NO_VERTEX) {
+				return fail(FATAL_ERROR_FAILED_TO_ADD_VERTEX);
+			}
+			VertexOfName[name] = static_cast<uint32_t>(VertexNames.size() - 1);
+			VertexNames.back() = name;
+		}
+		else if (Depth_ == 4 && Field_ == Field::ToVertex) {
+			Target_ = intern(str, length);
+			HasTarget_ = true;
+		}
+		else {
+			return false;
+		}
+		Field_ = Field::None;
+		return true;
+	}
+	bool Double(double d) {
+		if (skipValue()) return true;
+		if (Depth_ != 4 || Field_ != Field::Weight) return false;
+		Weight_ = d;
+		HasWeight_ = true;
+		Field_ = Field::None;
+		return true;
+	}
+	bool Int(int i) { return Double(i); }
+	bool Uint(unsigned u) { return Double(u); }
+	bool Int64(int64_t i) { return Double(static_cast<double>(i)); }
+	bool Uint64(uint64_t u) { return Double(static_cast<double>(u)); }
+	bool Null() { return skipValue(); }
+	bool Bool(bool) { return skipValue(); }
+
+private:
+	enum class Field { None, Name, Edges, ToVertex, Weight, Other };
+	std::unordered_map<std::string, uint32_t> NameNumbers_;
+	int Depth_ = 0;               //0 - outside, 1 - vertex array, 2 - vertex, 3 - edge array, 4 - edge
+	Field Field_ = Field::None;   //Member the next value belongs to
+	uint32_t Skip_ = 0;           //Depth inside a skipped value
+	uint32_t Target_ = 0;
+	weight_t Weight_ = 0;
+	bool HasTarget_ = false;
+	bool HasWeight_ = false;
+
+	uint32_t intern(const char* str, rapidjson::SizeType length) {
+		auto inserted = NameNumbers_.emplace(std::string(str, length), static_cast<uint32_t>(Names.size()));
+		if (inserted.second) {
+			Names.push_back(&inserted.first->first);
+			VertexOfName.push_back(CSR_NO_VERTEX);
+		}
+		return inserted.first->second;
+	}
+	bool fail(int error) {
+		Error = error;
+		return false;
+	}
+	//Scalar value of a skipped member
+	bool skipValue() {
+		if (Skip_ > 0) return true;
+		if (Field_ != Field::Other) return false;
+		Field_ = Field::None;
+		return true;
+	}
+	//Object or array of a skipped member
+	bool skipStart() {
+		if (Skip_ == 0 && Field_ != Field::Other) return false;
+		Skip_++;
+		return true;
+	}
+	bool skipEnd() {
+		if (Skip_ == 0) return false;
+		if (--Skip_ == 0) Field_ = Field::None;
+		return true;
+	}
+};
+
+//Reads the file through a fixed-size buffer into the handler
+//Returns NO_ERROR or an error code (error.h)
+static int streamJsonFile(const Settings& settings, GraphStreamHandler& handler) {
+	FILE* fd = fopen(settings.FilePath.c_str(), "rb");
+	if (!fd) {
+		return FATAL_ERROR_FILE_OPEN_FAILURE;
+	}
+	std::vector<char> buffer(1 << 16);
+	rapidjson::FileReadStream stream(fd, buffer.data(), buffer.size());
+	rapidjson::Reader reader;
+	bool parsed = !reader.Parse(stream, handler).IsError();
+	fclose(fd);
+	if (parsed) return NO_ERROR;
+	return handler.Error != NO_ERROR ? handler.Error : FATAL_ERROR_FILE_READ_FAILURE;
+}
+
+int streamGraph(Graph& graph, const Settings& settings) {
+	GraphStreamHandler handler;
+	int err = streamJsonFile(settings, handler);
+	if (err != NO_ERROR) {
+		return err;
+	}
+
+	std::vector<Vertex*> vertices(handler.VertexNames.size());
+	for (size_t v = 0; v < vertices.size(); v++) {
+		vertices[v] = addVertex(*handler.Names[handler.VertexNames[v]], graph, settings);
+		if (vertices[v] == nullptr) {
+			return FATAL_ERROR_FAILED_TO_ADD_VERTEX;
+		}
+	}
+	for (const auto& e : handler.Edges) {
+		uint32_t to = handler.VertexOfName[e.To];
+		if (to == CSR_NO_VERTEX) {
+			return FATAL_ERROR_TO_VERTEX_NOT_FOUND;
+		}
+		if (!addEdge(vertices[e.From], vertices[to], e.Weight, graph, settings)) {
+			return FATAL_ERROR_FAILED_TO_ADD_EDGE;
+		}
+	}
+	return NO_ERROR;
+}
+
+int streamCsrGraph(CsrGraph& csr, const Settings& settings) {
+	using namespace std;
+
+	vector<CsrEdge> edges;
+	csr = CsrGraph();
+	{
+		GraphStreamHandler handler;
+		int err = streamJsonFile(settings, handler);
+		if (err != NO_ERROR) {
+			return err;
+		}
+
+		//indices are assigned in the order of names, the same as loadCsrGraph() does
+		uint32_t vertex_count = static_cast<uint32_t>(handler.VertexNames.size());
+		vector<uint32_t> order(vertex_count);
+		for (uint32_t v = 0; v < vertex_count; v++) order[v] = v;
+		sort(order.begin(), order.end(), [&handler](uint32_t a, uint32_t b) {
+			return *handler.Names[handler.VertexNames[a]] < *handler.Names[handler.VertexNames[b]];
+		});
+		vector<uint32_t> index(vertex_count);
+		csr.Names.reserve(vertex_count);
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			index[order[i]] = i;
+			csr.Names.push_back(*handler.Names[handler.VertexNames[order[i]]]);
+		}
+
+		edges.reserve(handler.Edges.size());
+		for (const auto& e : handler.Edges) {
+			uint32_t to = handler.VertexOfName[e.To];
+			if (to == CSR_NO_VERTEX) {
+				return FATAL_ERROR_TO_VERTEX_NOT_FOUND;
+			}
+			if (!csrEdgeAllowed(index[e.From], index[to], e.Weight, settings)) {
+				return FATAL_ERROR_FAILED_TO_ADD_EDGE;
+			}
+			edges.push_back(CsrEdge{index[e.From], index[to], e.Weight});
+		}
+	}
+
+	return finishCsrGraph(edges, csr, settings);
+}
+
 int load2dGraph(Graph& graph, const Settings& settings) {
 	unsigned long long width = 0, height = 0;
 
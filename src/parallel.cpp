@@ -0,0 +1,459 @@
+/*
+ * parallel.cpp
+ *
+ *  Thread pool and parallel algorithms working on CsrGraph.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <system_error>
+#include "parallel.h"
+
+ThreadPool::ThreadPool(unsigned thread_count) {
+	if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned i = 1; i < thread_count; i++) {
+		//The system may refuse to start more threads: the pool works with the threads already started
+		try {
+			Workers_.emplace_back(&ThreadPool::work, this, i);
+		}
+		catch (const std::system_error&) {
+			break;
+		}
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(Mutex_);
+		Stop_ = true;
+	}
+	Start_.notify_all();
+	for (auto& worker : Workers_) worker.join();
+}
+
+void ThreadPool::runChunks(unsigned thread) {
+	for (;;) {
+		size_t begin = Next_.fetch_add(Grain_);
+		if (begin >= Count_) break;
+		(*Task_)(begin, std::min(begin + Grain_, Count_), thread);
+	}
+}
+
+void ThreadPool::work(unsigned thread) {
+	unsigned generation = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(Mutex_);
+			Start_.wait(lock, [&] { return Stop_ || Generation_ != generation; });
+			if (Stop_) return;
+			generation = Generation_;
+		}
+		runChunks(thread);
+		{
+			std::lock_guard<std::mutex> lock(Mutex_);
+			if (--Running_ == 0) Finish_.notify_one();
+		}
+	}
+}
+
+void ThreadPool::parallelFor(size_t count, const Task& task, size_t grain) {
+	if (count == 0) return;
+	if (Workers_.empty() || count <= grain) {
+		task(0, count, 0);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(Mutex_);
+		Task_ = &task;
+		Count_ = count;
+		Grain_ = grain;
+		Next_ = 0;
+		Running_ = static_cast<unsigned>(Workers_.size());
+		Generation_++;
+	}
+	Start_.notify_all();
+	runChunks(0);
+	std::unique_lock<std::mutex> lock(Mutex_);
+	Finish_.wait(lock, [&] { return Running_ == 0; });
+}
+
+//Lowers weight of vertex to new_weight if it is less than the current one. Returns true if the weight was lowered.
+static bool relaxAtomic(std::atomic<weight_t>& weight, weight_t new_weight) {
+	weight_t old_weight = weight.load(std::memory_order_relaxed);
+	while (new_weight < old_weight) {
+		if (weight.compare_exchange_weak(old_weight, new_weight, std::memory_order_relaxed)) return true;
+	}
+	return false;
+}
+
+void deltaStepping(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, ThreadPool& pool,
+		weight_t delta, CsrCallback callback, AlgoResult& result, void* user_context) {
+	uint32_t vertex_count = graph.vertexCount();
+	if (source >= vertex_count || (target != CSR_NO_VERTEX && target >= vertex_count)) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	}
+
+	weight_t max_weight = 0, min_weight = 0;
+	for (weight_t w : graph.Weights) {
+		max_weight = std::max(max_weight, w);
+		min_weight = std::min(min_weight, w);
+	}
+	//Buckets need non-negative weights: parallel Bellman-Ford finds minimal weight paths (or a negative loop) instead
+	if (min_weight < 0) {
+		CsrBellmanFordResult bellman_ford_result;
+		parallelBellmanFord(graph, source, target, workspace, pool, callback, bellman_ford_result, user_context);
+		result.ResultCode = bellman_ford_result.ResultCode;
+		return;
+	}
+	if (delta <= 0) {
+		delta = graph.edgeCount() ? max_weight * vertex_count / graph.edgeCount() : max_weight;
+		if (delta <= 0) delta = max_weight > 0 ? max_weight : 1;
+	}
+
+	ParallelSearchState& shared = workspace.Parallel;
+	shared.reset(vertex_count);
+	std::atomic<weight_t>* weight = shared.Weight.get();
+	std::vector<uint32_t> reached(1, source);   //vertices with finite weight: they are copied and restored in the end
+	shared.Reached[source] = shared.Query;
+	weight[source].store(0);
+
+	//Vertices with path weight in [i*delta, (i+1)*delta) are in bucket i. New path weight never exceeds
+	//current one by more than max_weight + delta, so buckets are used as a circular array.
+	auto bucketOf = [&](uint32_t v) { return static_cast<uint64_t>(weight[v].load(std::memory_order_relaxed) / delta); };
+	std::vector<std::vector<uint32_t>> buckets(static_cast<size_t>(max_weight / delta) + 2);
+	size_t entries = 0;        //number of entries in all buckets (including outdated ones)
+	std::vector<std::vector<uint32_t>> updated(pool.size());   //vertices whose weight was lowered by each thread
+	auto distribute = [&]() {
+		for (auto& list : updated) {
+			for (uint32_t v : list) {
+				buckets[bucketOf(v) % buckets.size()].push_back(v);
+				if (shared.Reached[v] != shared.Query) {
+					shared.Reached[v] = shared.Query;
+					reached.push_back(v);
+				}
+			}
+			entries += list.size();
+			list.clear();
+		}
+	};
+	buckets[0].push_back(source);
+	entries = 1;
+
+	std::vector<uint32_t> frontier, removed;
+	uint64_t current = 0;
+	uint64_t last_final_bucket = UINT64_MAX;   //weights in buckets up to this one are final
+
+	while (entries > 0) {
+		while (buckets[current % buckets.size()].empty()) current++;
+		removed.clear();
+		uint64_t bucket_mark = ++shared.Bucket;
+
+		//Light edges can put vertices back to current bucket, so repeat until it stays empty
+		for (;;) {
+			std::vector<uint32_t>& bucket = buckets[current % buckets.size()];
+			uint64_t round = ++shared.Round;
+			frontier.clear();
+			for (uint32_t v : bucket) {
+				if (bucketOf(v) != current || shared.RoundMark[v] == round) continue;
+				shared.RoundMark[v] = round;
+				frontier.push_back(v);
+				if (shared.RemovedMark[v] != bucket_mark) {
+					shared.RemovedMark[v] = bucket_mark;
+					removed.push_back(v);
+				}
+			}
+			entries -= bucket.size();
+			bucket.clear();
+			if (frontier.empty()) break;
+
+			pool.parallelFor(frontier.size(), [&](size_t begin, size_t end, unsigned thread) {
+				for (size_t i = begin; i < end; i++) {
+					uint32_t v = frontier[i];
+					weight_t v_weight = weight[v].load(std::memory_order_relaxed);
+					for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+						if (graph.Weights[j] <= delta && relaxAtomic(weight[graph.Targets[j]], v_weight + graph.Weights[j])) {
+							updated[thread].push_back(graph.Targets[j]);
+						}
+					}
+				}
+			}, 64);
+			distribute();
+		}
+
+		if (target != CSR_NO_VERTEX && weight[target].load() < INFINITE_WEIGHT && bucketOf(target) == current) {
+			last_final_bucket = current;
+			break;
+		}
+
+		pool.parallelFor(removed.size(), [&](size_t begin, size_t end, unsigned thread) {
+			for (size_t i = begin; i < end; i++) {
+				uint32_t v = removed[i];
+				weight_t v_weight = weight[v].load(std::memory_order_relaxed);
+				for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+					if (graph.Weights[j] > delta && relaxAtomic(weight[graph.Targets[j]], v_weight + graph.Weights[j])) {
+						updated[thread].push_back(graph.Targets[j]);
+					}
+				}
+			}
+		}, 64);
+		distribute();
+	}
+
+	//Copy final weights to the workspace and restore weights of the shared state
+	SearchState& state = workspace.Forward;
+	state.reset(vertex_count);
+	pool.parallelFor(reached.size(), [&](size_t begin, size_t end, unsigned) {
+		for (size_t i = begin; i < end; i++) {
+			uint32_t v = reached[i];
+			weight_t w = weight[v].load(std::memory_order_relaxed);
+			weight[v].store(INFINITE_WEIGHT, std::memory_order_relaxed);
+			if (static_cast<uint64_t>(w / delta) > last_final_bucket) continue;
+			state.touch(v);
+			state.Weight[v] = w;
+			state.Processed[v] = true;
+		}
+	}, 4096);
+
+	//Parents: breadth-first walk from source over edges that lie on minimal-weight paths
+	std::queue<uint32_t> q;
+	q.push(source);
+	while (!q.empty()) {
+		uint32_t v = q.front();
+		q.pop();
+		for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+			uint32_t to = graph.Targets[j];
+			if (to == source || !state.touched(to) || state.Parent[to] != CSR_NO_VERTEX) continue;
+			if (state.Weight[v] + graph.Weights[j] == state.Weight[to]) {
+				state.Parent[to] = v;
+				q.push(to);
+			}
+		}
+	}
+
+	if (target == CSR_NO_VERTEX) {
+		result.ResultCode = AlgoResultCode::Ok;
+	}
+	else if (state.weight(target) < INFINITE_WEIGHT) {
+		if (callback) callback(AlgoEvent::TargetFound, target, user_context);
+		result.ResultCode = AlgoResultCode::Found;
+	}
+	else {
+		result.ResultCode = AlgoResultCode::NotFound;
+	}
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+}
+
+//Joins vertex lists collected by threads into one list and clears them
+static void joinBuffers(ThreadPool& pool, std::vector<std::vector<uint32_t>>& buffers, std::vector<uint32_t>& list) {
+	std::vector<size_t> offsets(buffers.size() + 1);
+	for (size_t t = 0; t < buffers.size(); t++) offsets[t + 1] = offsets[t] + buffers[t].size();
+	list.resize(offsets.back());
+	pool.parallelFor(buffers.size(), [&](size_t begin, size_t end, unsigned) {
+		for (size_t t = begin; t < end; t++) {
+			std::copy(buffers[t].begin(), buffers[t].end(), list.begin() + offsets[t]);
+			buffers[t].clear();
+		}
+	}, 1);
+}
+
+//Finds a cycle of parents closed in the last pass of Bellman-Ford search. Such a cycle passes a vertex whose parent was
+//changed, so walks up the parents start from improved vertices only and stop at vertices visited by earlier walks.
+//walk - walk number that visited each vertex, walk_count - number of walks made so far (walk numbers are never reused)
+//cycle - vertices of the cycle in path order
+//Returns true if a cycle is found
+static bool findNewParentCycle(const SearchState& state, const std::vector<uint32_t>& improved, std::vector<uint64_t>& walk,
+		uint64_t& walk_count, std::vector<uint32_t>& cycle) {
+	uint64_t first_walk = walk_count + 1;
+	for (uint32_t start : improved) {
+		uint64_t current = ++walk_count;
+		uint32_t v = start;
+		while (v != CSR_NO_VERTEX && walk[v] < first_walk) {
+			walk[v] = current;
+			v = state.Parent[v];
+		}
+		if (v != CSR_NO_VERTEX && walk[v] == current) {
+			cycle.clear();
+			uint32_t u = v;
+			do {
+				cycle.push_back(u);
+				u = state.Parent[u];
+			} while (u != v);
+			std::reverse(cycle.begin(), cycle.end());
+			return true;
+		}
+	}
+	return false;
+}
+
+void parallelBellmanFord(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, ThreadPool& pool,
+		CsrCallback callback, CsrBellmanFordResult& result, void* user_context) {
+	uint32_t vertex_count = graph.vertexCount();
+	if (source >= vertex_count || (target != CSR_NO_VERTEX && target >= vertex_count)) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	}
+
+	SearchState& state = workspace.Forward;
+	state.reset(vertex_count);
+	result.NegativeCycle.clear();
+	std::vector<weight_t> next_weight(vertex_count);   //Weights computed by current pass for vertices in active list
+	std::vector<uint32_t> improved_pass(vertex_count);  //Last pass that improved the vertex, 0 if none did
+	std::unique_ptr<std::atomic<uint32_t>[]> active_pass(new std::atomic<uint32_t>[vertex_count]);   //Last pass the vertex was active in
+	pool.parallelFor(vertex_count, [&](size_t begin, size_t end, unsigned) {
+		for (size_t v = begin; v < end; v++) {
+			state.touch(static_cast<uint32_t>(v));
+			improved_pass[v] = 0;
+			active_pass[v].store(0, std::memory_order_relaxed);
+		}
+	}, 4096);
+	state.Weight[source] = 0;
+	improved_pass[source] = 1;
+
+	std::vector<uint32_t> improved(1, source), active;
+	std::vector<std::vector<uint32_t>> buffers(pool.size());
+	std::vector<uint64_t> walk(vertex_count, 0);
+	uint64_t walk_count = 0;
+
+	//Pass 1 is the initialization of source. A path without loops has at most n-1 edges, so passes 2..n find all paths
+	//and a vertex improved by pass n+1 means a negative loop even if parents show none.
+	for (uint32_t pass = 2; !improved.empty(); pass++) {
+		//Vertices that can be improved: targets of edges from the vertices improved by the previous pass
+		pool.parallelFor(improved.size(), [&](size_t begin, size_t end, unsigned thread) {
+			for (size_t i = begin; i < end; i++) {
+				uint32_t v = improved[i];
+				for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+					uint32_t to = graph.Targets[j];
+					if (active_pass[to].load(std::memory_order_relaxed) == pass ||
+							active_pass[to].exchange(pass, std::memory_order_relaxed) == pass) continue;
+					buffers[thread].push_back(to);
+				}
+			}
+		}, 64);
+		joinBuffers(pool, buffers, active);
+
+		//Weights and improvement marks of the previous pass are only read here, each active vertex is written by one thread
+		pool.parallelFor(active.size(), [&](size_t begin, size_t end, unsigned) {
+			for (size_t i = begin; i < end; i++) {
+				uint32_t v = active[i];
+				weight_t best = state.Weight[v];
+				for (uint32_t j = graph.ReverseOffsets[v]; j < graph.ReverseOffsets[v + 1]; j++) {
+					uint32_t from = graph.Sources[j];
+					if (improved_pass[from] != pass - 1) continue;
+					weight_t new_weight = state.Weight[from] + graph.ReverseWeights[j];
+					if (new_weight < best) {
+						best = new_weight;
+						state.Parent[v] = from;
+					}
+				}
+				next_weight[v] = best;
+			}
+		}, 256);
+
+		pool.parallelFor(active.size(), [&](size_t begin, size_t end, unsigned thread) {
+			for (size_t i = begin; i < end; i++) {
+				uint32_t v = active[i];
+				if (next_weight[v] < state.Weight[v]) {
+					state.Weight[v] = next_weight[v];
+					improved_pass[v] = pass;
+					buffers[thread].push_back(v);
+				}
+			}
+		}, 256);
+		joinBuffers(pool, buffers, improved);
+		if (improved.empty()) break;
+
+		if (findNewParentCycle(state, improved, walk, walk_count, result.NegativeCycle) || pass > vertex_count) {
+			uint32_t v = result.NegativeCycle.empty() ? improved.front() : result.NegativeCycle.front();
+			if (callback) callback(AlgoEvent::NegativeLoopDetected, v, user_context);
+			if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+			result.ResultCode = AlgoResultCode::NegativeLoopFound;
+			return;
+		}
+	}
+
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+	if (target == CSR_NO_VERTEX) {
+		result.ResultCode = AlgoResultCode::Ok;
+	}
+	else {
+		result.ResultCode = state.Weight[target] < INFINITE_WEIGHT ? AlgoResultCode::Found : AlgoResultCode::NotFound;
+	}
+}
+
+void parallelBfs(const CsrGraph& graph, uint32_t source, uint32_t target, QueryWorkspace& workspace, ThreadPool& pool,
+		CsrCallback callback, AlgoResult& result, void* user_context) {
+	uint32_t vertex_count = graph.vertexCount();
+	if (source >= vertex_count || (target != CSR_NO_VERTEX && target >= vertex_count)) {
+		result.ResultCode = AlgoResultCode::NoSourceOrTarget;
+		return;
+	}
+	if (source == target) {
+		result.ResultCode = AlgoResultCode::SourceIsTarget;
+		return;
+	}
+
+	SearchState& state = workspace.Forward;
+	state.reset(vertex_count);
+	ParallelSearchState& shared = workspace.Parallel;
+	shared.reset(vertex_count);
+	std::atomic<uint64_t>* visited = shared.Visited.get();
+
+	visited[source / 64].store(uint64_t(1) << (source % 64));
+	state.touch(source);
+	state.Weight[source] = 0;
+	std::vector<uint32_t> frontier(1, source), next;
+	std::vector<uint32_t> reached(1, source);   //all visited vertices: their bitmap words are cleared in the end
+	std::vector<std::vector<uint32_t>> buffers(pool.size());
+	std::atomic<bool> found(false);
+
+	for (weight_t level = 1; !frontier.empty() && !found; level++) {
+		pool.parallelFor(frontier.size(), [&](size_t begin, size_t end, unsigned thread) {
+			std::vector<uint32_t>& buffer = buffers[thread];
+			for (size_t i = begin; i < end && !found.load(std::memory_order_relaxed); i++) {
+				uint32_t v = frontier[i];
+				for (uint32_t j = graph.Offsets[v]; j < graph.Offsets[v + 1]; j++) {
+					uint32_t to = graph.Targets[j];
+					std::atomic<uint64_t>& word = visited[to / 64];
+					uint64_t bit = uint64_t(1) << (to % 64);
+					if ((word.load(std::memory_order_relaxed) & bit) || (word.fetch_or(bit, std::memory_order_relaxed) & bit)) continue;
+					//The vertex is claimed by this thread only, so its entries are written without synchronization
+					state.touch(to);
+					state.Weight[to] = level;
+					state.Parent[to] = v;
+					buffer.push_back(to);
+					if (to == target) found.store(true, std::memory_order_relaxed);
+				}
+			}
+		}, 64);
+
+		joinBuffers(pool, buffers, next);
+		frontier.swap(next);
+		reached.insert(reached.end(), frontier.begin(), frontier.end());
+	}
+	pool.parallelFor(reached.size(), [&](size_t begin, size_t end, unsigned) {
+		for (size_t i = begin; i < end; i++) visited[reached[i] / 64].store(0, std::memory_order_relaxed);
+	}, 4096);
+
+	if (target == CSR_NO_VERTEX) {
+		result.ResultCode = AlgoResultCode::Ok;
+	}
+	else if (found) {
+		if (callback) callback(AlgoEvent::TargetFound, target, user_context);
+		result.ResultCode = AlgoResultCode::Found;
+	}
+	else {
+		if (callback) callback(AlgoEvent::TargetNotFound, CSR_NO_VERTEX, user_context);
+		result.ResultCode = AlgoResultCode::NotFound;
+	}
+	if (callback) callback(AlgoEvent::AlgorithmFinished, CSR_NO_VERTEX, user_context);
+}
@@ -0,0 +1,114 @@
+/*
+ * pathtree.cpp
+ *
+ *  Output of minimal weight paths from source to all vertices.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include "pathtree.h"
+
+BufferedWriter::BufferedWriter(std::ostream& out, size_t capacity): Out_(out), Buffer_(capacity) {}
+
+void BufferedWriter::write(const char* data, size_t size) {
+	if (Size_ + size > Buffer_.size()) {
+		flush();
+		if (size > Buffer_.size()) {
+			Out_.write(data, size);
+			return;
+		}
+	}
+	memcpy(Buffer_.data() + Size_, data, size);
+	Size_ += size;
+}
+
+void BufferedWriter::write(const char* s) {
+	write(s, strlen(s));
+}
+
+void BufferedWriter::write(weight_t weight) {
+	char text[32];
+	int size = snprintf(text, sizeof(text), "%g", weight);
+	write(text, static_cast<size_t>(size));
+}
+
+void BufferedWriter::flush() {
+	if (Size_ > 0) Out_.write(Buffer_.data(), Size_);
+	Size_ = 0;
+}
+
+static void writeCompact(BufferedWriter& writer, uint32_t source, const SearchState& state, const std::vector<uint32_t>& order,
+		const std::vector<const std::string*>& names) {
+	for (uint32_t v : order) {
+		writer.write(*names[v]);
+		bool reached = state.weight(v) < INFINITE_WEIGHT;
+		if (reached && v != source) {
+			writer.write(" ", 1);
+			writer.write(*names[state.parent(v)]);
+			writer.write(" ", 1);
+		}
+		else {
+			writer.write(" - ", 3);
+		}
+		if (reached) writer.write(state.weight(v));
+		else writer.write("-", 1);
+		writer.write("\n", 1);
+	}
+}
+
+void writePathTree(std::ostream& out, uint32_t source, const SearchState& state, const std::vector<uint32_t>& order,
+		const std::vector<const std::string*>& names, bool compact) {
+	BufferedWriter writer(out);
+	if (compact) {
+		writeCompact(writer, source, state, order, names);
+		return;
+	}
+
+	//Children of every vertex in CSR form, in the order of vertices
+	size_t id_count = names.size();
+	std::vector<uint32_t> child_offsets(id_count + 1, 0);
+	for (uint32_t v : order) {
+		if (v != source && state.weight(v) < INFINITE_WEIGHT) child_offsets[state.parent(v) + 1]++;
+	}
+	for (size_t v = 0; v < id_count; v++) child_offsets[v + 1] += child_offsets[v];
+	std::vector<uint32_t> children(child_offsets[id_count]);
+	std::vector<uint32_t> next(child_offsets.begin(), child_offsets.end() - 1);
+	for (uint32_t v : order) {
+		if (v != source && state.weight(v) < INFINITE_WEIGHT) children[next[state.parent(v)]++] = v;
+	}
+
+	//Depth-first walk. Path holds the path to the vertex on top of the stack, every stack entry keeps the path length
+	//of the parent to cut the path back when the subtree is done.
+	struct Entry {
+		uint32_t Vertex;
+		uint32_t NextChild;     //Position of the next child in children array
+		size_t ParentLength;    //Length of the path to the parent
+	};
+	std::vector<Entry> stack;
+	std::string path;
+	auto enter = [&](uint32_t v) {
+		stack.push_back(Entry{v, child_offsets[v], path.size()});
+		if (!path.empty()) path += "->";
+		path += *names[v];
+		writer.write(path);
+		writer.write(" weight: ", 9);
+		writer.write(state.weight(v));
+		writer.write("\n", 1);
+	};
+	if (state.weight(source) < INFINITE_WEIGHT) enter(source);
+	while (!stack.empty()) {
+		Entry& top = stack.back();
+		if (top.NextChild == child_offsets[top.Vertex + 1]) {
+			path.resize(top.ParentLength);
+			stack.pop_back();
+			continue;
+		}
+		enter(children[top.NextChild++]);
+	}
+
+	for (uint32_t v : order) {
+		if (state.weight(v) < INFINITE_WEIGHT) continue;
+		writer.write(*names[v]);
+		writer.write(": no path from source to this vertex\n");
+	}
+}
@@ -0,0 +1,127 @@
+/*
+ * queue.cpp
+ *
+ *  Priority queues of vertex ids used by Dijkstra-family searches.
+ */
+
+#include "queue.h"
+
+void RadixQueue::reset(const weight_t* weights, vertex_id_t) {
+	Weights_ = weights;
+	for (auto& bucket : Buckets_) bucket.clear();
+	Infinite_.clear();
+	Last_ = 0;
+	Size_ = 0;
+}
+
+void RadixQueue::insert(uint64_t key, vertex_id_t v) {
+	int bucket = (key == Last_) ? 0 : 64 - __builtin_clzll(key ^ Last_);
+	Buckets_[bucket].push_back({key, v});
+}
+
+void RadixQueue::push(vertex_id_t v) {
+	weight_t w = Weights_[v];
+	if (w >= INFINITE_WEIGHT) {
+		Infinite_.push_back(v);
+	}
+	else {
+		insert(static_cast<uint64_t>(w), v);
+	}
+	Size_++;
+}
+
+void RadixQueue::decrease(vertex_id_t v) {
+	//The entry with the old key becomes outdated
+	insert(static_cast<uint64_t>(Weights_[v]), v);
+}
+
+vertex_id_t RadixQueue::top() {
+	std::vector<Entry>& first = Buckets_[0];
+	for (;;) {
+		while (!first.empty() && !isActual(first.back())) first.pop_back();
+		if (!first.empty()) return first.back().Vertex;
+
+		//Take the first non-empty bucket, its minimal key becomes the last extracted one
+		//and its entries are redistributed to lower buckets
+		int i = 1;
+		while (i < BUCKET_COUNT && Buckets_[i].empty()) i++;
+		if (i == BUCKET_COUNT) break;
+		//Entries never return to bucket i as they agree with the new last key in all bits starting from bit i-1
+		std::vector<Entry>& bucket = Buckets_[i];
+		uint64_t min_key = UINT64_MAX;
+		for (const auto& e : bucket) {
+			if (isActual(e) && e.Key < min_key) min_key = e.Key;
+		}
+		if (min_key != UINT64_MAX) {
+			Last_ = min_key;
+			for (const auto& e : bucket) {
+				if (isActual(e)) insert(e.Key, e.Vertex);
+			}
+		}
+		bucket.clear();
+	}
+
+	while (!Infinite_.empty() && Weights_[Infinite_.back()] < INFINITE_WEIGHT) Infinite_.pop_back();
+	return Infinite_.back();
+}
+
+void RadixQueue::pop() {
+	top();
+	if (!Buckets_[0].empty()) {
+		Buckets_[0].pop_back();
+	}
+	else {
+		Infinite_.pop_back();
+	}
+	Size_--;
+}
+
+void DialQueue::reset(const weight_t* weights, vertex_id_t) {
+	Weights_ = weights;
+	for (auto& b : Buckets_) b.clear();
+	Infinite_.clear();
+	Current_ = 0;
+	Size_ = 0;
+}
+
+void DialQueue::push(vertex_id_t v) {
+	weight_t w = Weights_[v];
+	if (w >= INFINITE_WEIGHT) {
+		Infinite_.push_back(v);
+	}
+	else {
+		bucket(w).push_back(v);
+	}
+	Size_++;
+}
+
+void DialQueue::decrease(vertex_id_t v) {
+	//The entry with the old key becomes outdated
+	bucket(Weights_[v]).push_back(v);
+}
+
+vertex_id_t DialQueue::top() {
+	//All finite keys are within Buckets_.size() from the current one, so a full turn finds them
+	for (size_t scanned = 0; scanned < Buckets_.size(); scanned++) {
+		std::vector<vertex_id_t>& current = bucket(static_cast<weight_t>(Current_));
+		while (!current.empty() && Weights_[current.back()] != static_cast<weight_t>(Current_)) current.pop_back();
+		if (!current.empty()) return current.back();
+		Current_++;
+	}
+	Current_ -= Buckets_.size();
+
+	while (!Infinite_.empty() && Weights_[Infinite_.back()] < INFINITE_WEIGHT) Infinite_.pop_back();
+	return Infinite_.back();
+}
+
+void DialQueue::pop() {
+	top();
+	std::vector<vertex_id_t>& current = bucket(static_cast<weight_t>(Current_));
+	if (!current.empty()) {
+		current.pop_back();
+	}
+	else {
+		Infinite_.pop_back();
+	}
+	Size_--;
+}
@@ -23,7 +23,27 @@ map <Algorithm, string> AlgorithmNames = {
 		{Algorithm::Dijkstra, "Dijkstra"},
 		{Algorithm::FastDijkstra, "Fast Dijkstra"},
 		{Algorithm::BellmanFord, "Bellman-Ford"},
-		{Algorithm::Dijkstra, "Dijkstra2D"}
+		{Algorithm::Dijkstra2D, "Dijkstra2D"},
+		{Algorithm::DialDijkstra, "Dial"},
+		{Algorithm::DeltaStepping, "Delta-stepping"},
+		{Algorithm::DirectionOptimizingBfs, "Direction-optimizing BFS"},
+		{Algorithm::ParallelBfs, "Parallel BFS"},
+		{Algorithm::BidirectionalBfs, "Bidirectional BFS"},
+		{Algorithm::AStar, "A*"},
+		{Algorithm::Alt, "ALT"},
+		{Algorithm::BidirectionalAlt, "Bidirectional ALT"},
+		{Algorithm::ContractionHierarchies, "Contraction hierarchies"},
+		{Algorithm::HubLabels, "Hub labeling"},
+		{Algorithm::Spfa, "SPFA"},
+		{Algorithm::ParallelBellmanFord, "Parallel Bellman-Ford"},
+		{Algorithm::AllPairs, "All-pairs shortest paths"}
+};
+
+map <string, QueueType> QueueArgs = {
+		{"binomial", QueueType::Binomial},
+		{"dary", QueueType::DaryHeap},
+		{"pairing", QueueType::Pairing},
+		{"radix", QueueType::Radix}
 };
 
 map <string, Algorithm> AlgorithmArgs = {
@@ -32,7 +52,39 @@ map <string, Algorithm> AlgorithmArgs = {
 		{"dijkstra", Algorithm::Dijkstra},
 		{"dijkstra2d", Algorithm::Dijkstra2D},
 		{"fast-dijkstra", Algorithm::FastDijkstra},
-		{"bellman-ford", Algorithm::BellmanFord}
+		{"bellman-ford", Algorithm::BellmanFord},
+		{"dial", Algorithm::DialDijkstra},
+		{"delta-stepping", Algorithm::DeltaStepping},
+		{"hybrid-bfs", Algorithm::DirectionOptimizingBfs},
+		{"parallel-bfs", Algorithm::ParallelBfs},
+		{"bidirectional-bfs", Algorithm::BidirectionalBfs},
+		{"astar", Algorithm::AStar},
+		{"alt", Algorithm::Alt},
+		{"bidirectional-alt", Algorithm::BidirectionalAlt},
+		{"ch", Algorithm::ContractionHierarchies},
+		{"hub-labels", Algorithm::HubLabels},
+		{"spfa", Algorithm::Spfa},
+		{"parallel-bellman-ford", Algorithm::ParallelBellmanFord},
+		{"apsp", Algorithm::AllPairs}
+};
+
+map <string, HeuristicType> HeuristicArgs = {
+		{"auto", HeuristicType::Auto},
+		{"zero", HeuristicType::Zero},
+		{"manhattan", HeuristicType::Manhattan},
+		{"octile", HeuristicType::Octile},
+		{"euclidean", HeuristicType::Euclidean}
+};
+
+map <string, LandmarkSelection> LandmarkSelectionArgs = {
+		{"farthest", LandmarkSelection::Farthest},
+		{"avoid", LandmarkSelection::Avoid}
+};
+
+map <string, ApspMethod> ApspMethodArgs = {
+		{"auto", ApspMethod::Auto},
+		{"floyd-warshall", ApspMethod::FloydWarshall},
+		{"dijkstra", ApspMethod::Dijkstra}
 };
 
 static const option longOpts[] = {
@@ -51,15 +103,31 @@ static const option longOpts[] = {
 	{ "verbose", no_argument, NULL, 'v' },
 	{ "width", required_argument, NULL, 'X' },
 	{ "height", required_argument, NULL, 'Y' },
+	{ "csr", no_argument, NULL, 'c' },
+	{ "lazy-queue", no_argument, NULL, 'q' },
+	{ "queue", required_argument, NULL, 'p' },
+	{ "benchmark", required_argument, NULL, 'b' },
+	{ "delta", required_argument, NULL, 'd' },
+	{ "threads", required_argument, NULL, 't' },
+	{ "heuristic", required_argument, NULL, 'H' },
+	{ "landmarks", required_argument, NULL, 'k' },
+	{ "landmark-selection", required_argument, NULL, 'K' },
+	{ "preprocess", no_argument, NULL, 'P' },
+	{ "reweight", no_argument, NULL, 'R' },
+	{ "apsp-method", required_argument, NULL, 'A' },
+	{ "matrix-file", required_argument, NULL, 'M' },
+	{ "query-file", required_argument, NULL, 'Q' },
+	{ "compact-paths", no_argument, NULL, 'C' },
+	{ "stream-json", no_argument, NULL, 'j' },
 	{ "help", no_argument, NULL, 'h' },
     { NULL, no_argument, NULL, 0 }
 };
 
-static const char *optString = "a:E:V:vw:W:LBF:S:T:hlsX:Y:?";
+static const char *optString = "a:A:b:cCd:E:V:vw:W:LBF:H:jk:K:M:p:PQ:RS:T:t:hlqsX:Y:?";
 
 void displayUsage () {
 	cout << " GraphCreator [OPTIONS]\nOptions are:\n";
-	cout << "\t-a, --algorithm\t\t\tAlgorithm to use: bfs, dfs, dijkstra, dijkstra2d, fast-dijkstra, bellman-ford\n";
+	cout << "\t-a, --algorithm\t\t\tAlgorithm to use: bfs, dfs, dijkstra, dijkstra2d, fast-dijkstra, bellman-ford, dial, delta-stepping,\n\t\t\t\t\thybrid-bfs, parallel-bfs, bidirectional-bfs, astar, alt,\n\t\t\t\t\tbidirectional-alt, ch, hub-labels, spfa, parallel-bellman-ford, apsp\n";
 	cout << "\t-F, --file\t\t\tPath to a file\n";
 	cout << "\t-l, --load\t\t\tLoad graph to a file\n";
 	cout << "\t-s, --save\t\t\tSave graph from file\n";
@@ -73,6 +141,26 @@ void displayUsage () {
 	cout << "\t-Y, --height\t\t\tHeight of 2d graph\n";
 	cout << "\t-S, --source-vertex\t\tSource vertex for single-source search\n";
 	cout << "\t-T, --target-vertex\t\tTarget vertex to find path to\n";
+	cout << "\t-c, --csr\t\t\tRun algorithm on compressed sparse row representation of the graph\n";
+	cout << "\t-j, --stream-json\t\tLoad json graph with the streaming parser: no document of the file is built\n";
+	cout << "\t-C, --compact-paths\t\tPrint paths to all vertices (search without target) as \"vertex parent weight\" lines\n";
+	cout << "\t-q, --lazy-queue\t\tPush vertices to priority queue when they are reached instead of pushing all vertices before search\n";
+	cout << "\t-p, --queue\t\t\tPriority queue of Dijkstra searches: binomial (default), dary, pairing, radix\n";
+	cout << "\t-b, --benchmark\t\t\tRun given number of queries between random vertices and report time spent\n"
+			"\t\t\t\t\t(all-pairs search runs once and reports its time)\n";
+	cout << "\t-d, --delta\t\t\tBucket width of delta-stepping (default: max edge weight / average out-degree)\n";
+	cout << "\t-t, --threads\t\t\tNumber of threads of parallel algorithms (default: number of hardware threads)\n";
+	cout << "\t-H, --heuristic\t\t\tHeuristic of A* search: auto (default: manhattan for 2d graph, zero otherwise), zero, manhattan, octile, euclidean\n";
+	cout << "\t-k, --landmarks\t\t\tNumber of landmarks of ALT search (default: 16)\n";
+	cout << "\t-K, --landmark-selection\tThe way landmarks are picked: avoid (default), farthest\n";
+	cout << "\t-P, --preprocess\t\tRun preprocessing (landmarks of ALT search, contraction hierarchy, hub labels, potentials of reweighting)\n"
+			"\t\t\t\t\tand save it next to the graph file. Without this key saved preprocessing is used if it is found\n";
+	cout << "\t-R, --reweight\t\t\tRun search on the graph reweighted with Johnson's potentials: allows Dijkstra-family searches\n"
+			"\t\t\t\t\tand their preprocessing on graphs with negative edge weights\n";
+	cout << "\t-A, --apsp-method\t\tMethod of all-pairs search: auto (default: by graph density), floyd-warshall, dijkstra\n";
+	cout << "\t-M, --matrix-file\t\tSave distance matrix (apsp, many-to-many query) to a binary file instead of printing it\n";
+	cout << "\t-Q, --query-file\t\tMany-to-many query: text file with vertex names after \"sources:\" and \"targets:\" keywords.\n"
+			"\t\t\t\t\tch finds the distance matrix by bucket-based search, apsp by Dijkstra search from every source\n";
 	cout << "\t-v, --verbose\t\t\tPrint additional information\n";
 	cout << "\t-h, --help\t\t\tShow this help information\n";
 	exit(0);
@@ -103,6 +191,55 @@ void Settings::print () {
 	if (this->SaveToFile) {
 		cout << "\tSave graph to the file."<< "\n";
 	}
+	if (this->UseCsr) {
+		cout << "\tUse compressed sparse row representation."<< "\n";
+	}
+	if (this->LazyQueue) {
+		cout << "\tLazy priority queue insertion."<< "\n";
+	}
+	for (const auto& pair : QueueArgs) {
+		if (pair.second == this->Queue) cout << "\tPriority queue: " << pair.first << "\n";
+	}
+	if (this->BenchmarkQueries > 0) {
+		cout << "\tBenchmark queries: " << this->BenchmarkQueries << "\n";
+	}
+	if (this->Delta > 0) {
+		cout << "\tDelta: " << this->Delta << "\n";
+	}
+	if (this->Threads > 0) {
+		cout << "\tThreads: " << this->Threads << "\n";
+	}
+	for (const auto& pair : HeuristicArgs) {
+		if (pair.second == this->Heuristic && this->SearchAlgorithm == Algorithm::AStar) cout << "\tHeuristic: " << pair.first << "\n";
+	}
+	if (this->SearchAlgorithm == Algorithm::Alt || this->SearchAlgorithm == Algorithm::BidirectionalAlt) {
+		for (const auto& pair : LandmarkSelectionArgs) {
+			if (pair.second == this->Landmarks) cout << "\tLandmarks: " << this->LandmarkCount << ", " << pair.first << " selection\n";
+		}
+	}
+	if (this->Preprocess) {
+		cout << "\tRun preprocessing and save it."<< "\n";
+	}
+	if (this->Reweight) {
+		cout << "\tReweight graph with Johnson's potentials."<< "\n";
+	}
+	if (this->SearchAlgorithm == Algorithm::AllPairs) {
+		for (const auto& pair : ApspMethodArgs) {
+			if (pair.second == this->Apsp) cout << "\tAll-pairs method: " << pair.first << "\n";
+		}
+	}
+	if (this->MatrixFile != "") {
+		cout << "\tMatrix file: " << this->MatrixFile << "\n";
+	}
+	if (this->QueryFile != "") {
+		cout << "\tQuery file: " << this->QueryFile << "\n";
+	}
+	if (this->CompactPaths) {
+		cout << "\tCompact paths output."<< "\n";
+	}
+	if (this->StreamJson) {
+		cout << "\tStreaming json loader."<< "\n";
+	}
 
 	if (this->SearchAlgorithm != Algorithm::None) {
 		cout << "\tApply algorithm: " << AlgorithmNames[this->SearchAlgorithm] << "\n";
@@ -156,6 +293,110 @@ int Settings::parse (int argc, char **argv) {
 				this->SaveToFile = true;
 				break;
 
+			case 'c':
+				this->UseCsr = true;
+				break;
+
+			case 'q':
+				this->LazyQueue = true;
+				break;
+
+			case 'b':
+				this->BenchmarkQueries = atoi(optarg);
+				break;
+
+			case 'd':
+				this->Delta = atof(optarg);
+				break;
+
+			case 't':
+				this->Threads = atoi(optarg);
+				if (this->Threads < 0 || this->Threads > MAX_THREADS) {
+					cerr << "Number of threads must be from 0 to " << MAX_THREADS << ": " << optarg << endl;
+					exit(-20);
+				}
+				break;
+
+			case 'p': {
+				string s(optarg);
+				transform(s.begin(), s.end(), s.begin(),
+				    [](unsigned char c){ return std::tolower(c); });
+				if (QueueArgs.find(s) == QueueArgs.end()) {
+					cerr << "Unknown priority queue: " << s << endl;
+					exit(-20);
+				}
+				this->Queue = QueueArgs[s];
+				break;
+			}
+
+			case 'H': {
+				string s(optarg);
+				transform(s.begin(), s.end(), s.begin(),
+				    [](unsigned char c){ return std::tolower(c); });
+				if (HeuristicArgs.find(s) == HeuristicArgs.end()) {
+					cerr << "Unknown heuristic: " << s << endl;
+					exit(-20);
+				}
+				this->Heuristic = HeuristicArgs[s];
+				break;
+			}
+
+			case 'k':
+				this->LandmarkCount = atoi(optarg);
+				if (this->LandmarkCount < 1) {
+					cerr << "Number of landmarks must be at least 1: " << optarg << endl;
+					exit(-20);
+				}
+				break;
+
+			case 'K': {
+				string s(optarg);
+				transform(s.begin(), s.end(), s.begin(),
+				    [](unsigned char c){ return std::tolower(c); });
+				if (LandmarkSelectionArgs.find(s) == LandmarkSelectionArgs.end()) {
+					cerr << "Unknown landmark selection: " << s << endl;
+					exit(-20);
+				}
+				this->Landmarks = LandmarkSelectionArgs[s];
+				break;
+			}
+
+			case 'P':
+				this->Preprocess = true;
+				break;
+
+			case 'R':
+				this->Reweight = true;
+				break;
+
+			case 'A': {
+				string s(optarg);
+				transform(s.begin(), s.end(), s.begin(),
+				    [](unsigned char c){ return std::tolower(c); });
+				if (ApspMethodArgs.find(s) == ApspMethodArgs.end()) {
+					cerr << "Unknown all-pairs method: " << s << endl;
+					exit(-20);
+				}
+				this->Apsp = ApspMethodArgs[s];
+				break;
+			}
+
+			case 'M':
+				this->MatrixFile = optarg;
+				break;
+
+			case 'Q':
+				this->QueryFile = optarg;
+				break;
+
+			case 'C':
+				this->CompactPaths = true;
+				break;
+
+			case 'j':
+				this->StreamJson = true;
+				break;
+
 			case 'a': {
 				string s(optarg);
 				transform(s.begin(), s.end(), s.begin(),
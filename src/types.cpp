@@ -4,10 +4,11 @@
  *  Created on: 22 . 2020 .
  *      Author: Serkin
  */
+#include <utility>
 #include "types.h"
 
 
-Vertex::Vertex(std::string _Name): Name(_Name) {
+Vertex::Vertex(std::string _Name): Name(std::move(_Name)) {
 	IncomingEdges = new EdgeList();
 	OutcomingEdges = new EdgeList();
 };
@@ -0,0 +1,37 @@
+/*
+ * workspace.cpp
+ *
+ *  Per-query state of shortest path algorithms kept in arrays indexed by vertex id.
+ */
+
+#include <algorithm>
+#include "workspace.h"
+
+void SearchState::reset(vertex_id_t vertex_count) {
+	if (Stamp.size() < vertex_count) {
+		Weight.resize(vertex_count);
+		Parent.resize(vertex_count);
+		Processed.resize(vertex_count);
+		Stamp.resize(vertex_count, 0);
+	}
+	//Stamps are cleared only when the epoch counter wraps around
+	if (++Epoch == 0) {
+		std::fill(Stamp.begin(), Stamp.end(), 0);
+		Epoch = 1;
+	}
+}
+
+void ParallelSearchState::reset(vertex_id_t vertex_count) {
+	if (VertexCount < vertex_count) {
+		size_t word_count = (static_cast<size_t>(vertex_count) + 63) / 64;
+		Weight.reset(new std::atomic<weight_t>[vertex_count]);
+		Visited.reset(new std::atomic<uint64_t>[word_count]);
+		for (vertex_id_t v = 0; v < vertex_count; v++) Weight[v].store(INFINITE_WEIGHT, std::memory_order_relaxed);
+		for (size_t w = 0; w < word_count; w++) Visited[w].store(0, std::memory_order_relaxed);
+		Reached.resize(vertex_count, 0);
+		RoundMark.resize(vertex_count, 0);
+		RemovedMark.resize(vertex_count, 0);
+		VertexCount = vertex_count;
+	}
+	Query++;
+}
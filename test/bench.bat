@@ -0,0 +1,32 @@
+rem Benchmark matrix of Dijkstra-family searches on bundled graphs:
+rem every priority queue (binomial, dary, pairing, radix) with eager and lazy insertion,
+rem Dial's bucket queue, parallel delta-stepping, ALT searches with landmarks, contraction hierarchies and hub labels,
+rem Bellman-Ford family searches (sequential, queue-based and parallel), all-pairs search by both methods.
+rem Usage: bench.bat [number of queries]
+set QUERIES=%1
+if "%QUERIES%"=="" set QUERIES=200
+for %%f in (..\v10e20weighted.json ..\v100e200weighted.json ..\v256e512weighted.json ..\v2048e65566weighted.json ..\v65535e200000weighted.json) do (
+	for %%a in (dijkstra fast-dijkstra) do (
+		for %%p in (binomial dary pairing radix) do (
+			..\Debug\GraphCreator.exe -F %%f -l -a %%a -p %%p -b %QUERIES%
+			..\Debug\GraphCreator.exe -F %%f -l -a %%a -p %%p -b %QUERIES% -c
+			..\Debug\GraphCreator.exe -F %%f -l -a %%a -p %%p -b %QUERIES% -q
+			..\Debug\GraphCreator.exe -F %%f -l -a %%a -p %%p -b %QUERIES% -q -c
+		)
+	)
+	..\Debug\GraphCreator.exe -F %%f -l -a dial -b %QUERIES%
+	..\Debug\GraphCreator.exe -F %%f -l -a dial -b %QUERIES% -c
+	..\Debug\GraphCreator.exe -F %%f -l -a dial -b %QUERIES% -q
+	..\Debug\GraphCreator.exe -F %%f -l -a dial -b %QUERIES% -q -c
+	..\Debug\GraphCreator.exe -F %%f -l -a delta-stepping -b %QUERIES%
+	..\Debug\GraphCreator.exe -F %%f -l -a alt -p dary -b %QUERIES% -q
+	..\Debug\GraphCreator.exe -F %%f -l -a bidirectional-alt -p dary -b %QUERIES% -q
+	..\Debug\GraphCreator.exe -F %%f -l -a ch -p dary -b %QUERIES% -q
+	..\Debug\GraphCreator.exe -F %%f -l -a hub-labels -b %QUERIES%
+	..\Debug\GraphCreator.exe -F %%f -l -a bellman-ford -b %QUERIES% -c
+	..\Debug\GraphCreator.exe -F %%f -l -a spfa -b %QUERIES% -c
+	..\Debug\GraphCreator.exe -F %%f -l -a parallel-bellman-ford -b %QUERIES%
+	..\Debug\GraphCreator.exe -F %%f -l -a apsp -A floyd-warshall -b 1 -M apsp.matrix
+	..\Debug\GraphCreator.exe -F %%f -l -a apsp -A dijkstra -b 1 -M apsp.matrix
+)
+del apsp.matrix
@@ -0,0 +1,37 @@
+# Benchmark matrix of Dijkstra-family searches on bundled graphs:
+# every priority queue (binomial, dary, pairing, radix) with eager and lazy insertion,
+# Dial's bucket queue, parallel delta-stepping, ALT searches with landmarks, contraction hierarchies and hub labels,
+# Bellman-Ford family searches (sequential, queue-based and parallel), all-pairs search by both methods.
+# Usage: bench.sh [number of queries]
+QUERIES=${1:-200}
+for f in ../v10e20weighted.json ../v100e200weighted.json ../v256e512weighted.json ../v2048e65566weighted.json ../v65535e200000weighted.json; do
+	for a in dijkstra fast-dijkstra; do
+		for queue in binomial dary pairing radix; do
+			for mode in "" "-q"; do
+				echo "=== $f $a $queue $mode"
+				../Debug/GraphCreator -F $f -l -a $a -p $queue -b $QUERIES $mode | grep -v "GraphCreator \[OPTIONS\]"
+				../Debug/GraphCreator -F $f -l -a $a -p $queue -b $QUERIES $mode -c | grep -v "GraphCreator \[OPTIONS\]"
+			done
+		done
+	done
+	for mode in "" "-q"; do
+		echo "=== $f dial $mode"
+		../Debug/GraphCreator -F $f -l -a dial -b $QUERIES $mode | grep -v "GraphCreator \[OPTIONS\]"
+		../Debug/GraphCreator -F $f -l -a dial -b $QUERIES $mode -c | grep -v "GraphCreator \[OPTIONS\]"
+	done
+	echo "=== $f delta-stepping"
+	../Debug/GraphCreator -F $f -l -a delta-stepping -b $QUERIES | grep -v "GraphCreator \[OPTIONS\]"
+	for a in alt bidirectional-alt ch hub-labels; do
+		echo "=== $f $a"
+		../Debug/GraphCreator -F $f -l -a $a -p dary -b $QUERIES -q | grep -v "GraphCreator \[OPTIONS\]"
+	done
+	for a in bellman-ford spfa parallel-bellman-ford; do
+		echo "=== $f $a"
+		../Debug/GraphCreator -F $f -l -a $a -b $QUERIES -c | grep -v "GraphCreator \[OPTIONS\]"
+	done
+	for m in floyd-warshall dijkstra; do
+		echo "=== $f apsp $m"
+		../Debug/GraphCreator -F $f -l -a apsp -A $m -b 1 -M apsp.matrix | grep -v "GraphCreator \[OPTIONS\]"
+	done
+done
+rm -f apsp.matrix
@@ -37,4 +37,233 @@
 ../Debug/GraphCreator -F test4.json -l -a  fast-dijkstra -S V0 -T V1 > results/test_results_fd4.txt
 ../Debug/GraphCreator -F test5.json -l -a  fast-dijkstra -S V0 -T V1 > results/test_results_fd5.txt 
 ../Debug/GraphCreator -F test6.json -l -a  fast-dijkstra -S V0 -T V1 > results/test_results_fd6.txt
-../Debug/GraphCreator -F test7.json -l -a  fast-dijkstra -S V0 -T V1 > results/test_results_fd7.txt
\ No newline at end of file
+../Debug/GraphCreator -F test7.json -l -a  fast-dijkstra -S V0 -T V1 > results/test_results_fd7.txt
+../Debug/GraphCreator -F test0.json -l -a  dijkstra --csr -S V0 -T V0 > results/test_results_csr_d0.txt
+../Debug/GraphCreator -F test1.json -l -a  dijkstra --csr -S V0 -T V0 > results/test_results_csr_d1.txt
+../Debug/GraphCreator -F test2.json -l -a  dijkstra --csr -S V0 -T V1 > results/test_results_csr_d2.txt
+../Debug/GraphCreator -F test3.json -l -a  dijkstra --csr -S V0 -T V1 > results/test_results_csr_d3.txt
+../Debug/GraphCreator -F test4.json -l -a  dijkstra --csr -S V0 -T V1 > results/test_results_csr_d4.txt
+../Debug/GraphCreator -F test5.json -l -a  dijkstra --csr -S V0 -T V1 > results/test_results_csr_d5.txt
+../Debug/GraphCreator -F test6.json -l -a  dijkstra --csr -S V0 -T V1 > results/test_results_csr_d6.txt
+../Debug/GraphCreator -F test7.json -l -a  dijkstra --csr -S V0 -T V1 > results/test_results_csr_d7.txt
+../Debug/GraphCreator -F test0.json -l -a  bellman-ford --csr -S V0 -T V0 > results/test_results_csr_bf0.txt
+../Debug/GraphCreator -F test1.json -l -a  bellman-ford --csr -S V0 -T V0 > results/test_results_csr_bf1.txt
+../Debug/GraphCreator -F test2.json -l -a  bellman-ford --csr -S V0 -T V1 > results/test_results_csr_bf2.txt
+../Debug/GraphCreator -F test3.json -l -a  bellman-ford --csr -S V0 -T V1 > results/test_results_csr_bf3.txt
+../Debug/GraphCreator -F test4.json -l -a  bellman-ford --csr -S V0 -T V1 > results/test_results_csr_bf4.txt
+../Debug/GraphCreator -F test5.json -l -a  bellman-ford --csr -S V0 -T V1 > results/test_results_csr_bf5.txt
+../Debug/GraphCreator -F test6.json -l -a  bellman-ford --csr -S V0 -T V1 > results/test_results_csr_bf6.txt
+../Debug/GraphCreator -F test7.json -l -a  bellman-ford --csr -S V0 -T V1 > results/test_results_csr_bf7.txt
+../Debug/GraphCreator -F test0.json -l -a  dijkstra -p dary -S V0 -T V0 > results/test_results_dary_d0.txt
+../Debug/GraphCreator -F test1.json -l -a  dijkstra -p dary -S V0 -T V0 > results/test_results_dary_d1.txt
+../Debug/GraphCreator -F test2.json -l -a  dijkstra -p dary -S V0 -T V1 > results/test_results_dary_d2.txt
+../Debug/GraphCreator -F test3.json -l -a  dijkstra -p dary -S V0 -T V1 > results/test_results_dary_d3.txt
+../Debug/GraphCreator -F test4.json -l -a  dijkstra -p dary -S V0 -T V1 > results/test_results_dary_d4.txt
+../Debug/GraphCreator -F test5.json -l -a  dijkstra -p dary -S V0 -T V1 > results/test_results_dary_d5.txt
+../Debug/GraphCreator -F test6.json -l -a  dijkstra -p dary -S V0 -T V1 > results/test_results_dary_d6.txt
+../Debug/GraphCreator -F test7.json -l -a  dijkstra -p dary -S V0 -T V1 > results/test_results_dary_d7.txt
+../Debug/GraphCreator -F test0.json -l -a  dijkstra -p radix -S V0 -T V0 > results/test_results_radix_d0.txt
+../Debug/GraphCreator -F test1.json -l -a  dijkstra -p radix -S V0 -T V0 > results/test_results_radix_d1.txt
+../Debug/GraphCreator -F test2.json -l -a  dijkstra -p radix -S V0 -T V1 > results/test_results_radix_d2.txt
+../Debug/GraphCreator -F test3.json -l -a  dijkstra -p radix -S V0 -T V1 > results/test_results_radix_d3.txt
+../Debug/GraphCreator -F test4.json -l -a  dijkstra -p radix -S V0 -T V1 > results/test_results_radix_d4.txt
+../Debug/GraphCreator -F test5.json -l -a  dijkstra -p radix -S V0 -T V1 > results/test_results_radix_d5.txt
+../Debug/GraphCreator -F test6.json -l -a  dijkstra -p radix -S V0 -T V1 > results/test_results_radix_d6.txt
+../Debug/GraphCreator -F test7.json -l -a  dijkstra -p radix -S V0 -T V1 > results/test_results_radix_d7.txt
+../Debug/GraphCreator -F test0.json -l -a  dial -S V0 -T V0 > results/test_results_dial0.txt
+../Debug/GraphCreator -F test1.json -l -a  dial -S V0 -T V0 > results/test_results_dial1.txt
+../Debug/GraphCreator -F test2.json -l -a  dial -S V0 -T V1 > results/test_results_dial2.txt
+../Debug/GraphCreator -F test3.json -l -a  dial -S V0 -T V1 > results/test_results_dial3.txt
+../Debug/GraphCreator -F test4.json -l -a  dial -S V0 -T V1 > results/test_results_dial4.txt
+../Debug/GraphCreator -F test5.json -l -a  dial -S V0 -T V1 > results/test_results_dial5.txt
+../Debug/GraphCreator -F test6.json -l -a  dial -S V0 -T V1 > results/test_results_dial6.txt
+../Debug/GraphCreator -F test7.json -l -a  dial -S V0 -T V1 > results/test_results_dial7.txt
+../Debug/GraphCreator -F test0.json -l -a delta-stepping -S V0 -T V0 > results/test_results_ds0.txt
+../Debug/GraphCreator -F test1.json -l -a delta-stepping -S V0 -T V0 > results/test_results_ds1.txt
+../Debug/GraphCreator -F test2.json -l -a delta-stepping -S V0 -T V1 > results/test_results_ds2.txt
+../Debug/GraphCreator -F test3.json -l -a delta-stepping -S V0 -T V1 > results/test_results_ds3.txt
+../Debug/GraphCreator -F test4.json -l -a delta-stepping -S V0 -T V1 > results/test_results_ds4.txt
+../Debug/GraphCreator -F test5.json -l -a delta-stepping -S V0 -T V1 > results/test_results_ds5.txt
+../Debug/GraphCreator -F test6.json -l -a delta-stepping -S V0 -T V1 > results/test_results_ds6.txt
+../Debug/GraphCreator -F test7.json -l -a delta-stepping -S V0 -T V1 > results/test_results_ds7.txt
+../Debug/GraphCreator -F test0.json -l -a hybrid-bfs -S V0 -T V0 > results/test_results_hbfs0.txt
+../Debug/GraphCreator -F test1.json -l -a hybrid-bfs -S V0 -T V0 > results/test_results_hbfs1.txt
+../Debug/GraphCreator -F test2.json -l -a hybrid-bfs -S V0 -T V1 > results/test_results_hbfs2.txt
+../Debug/GraphCreator -F test3.json -l -a hybrid-bfs -S V0 -T V1 > results/test_results_hbfs3.txt
+../Debug/GraphCreator -F test4.json -l -a hybrid-bfs -S V0 -T V1 > results/test_results_hbfs4.txt
+../Debug/GraphCreator -F test5.json -l -a hybrid-bfs -S V0 -T V1 > results/test_results_hbfs5.txt
+../Debug/GraphCreator -F test6.json -l -a hybrid-bfs -S V0 -T V1 > results/test_results_hbfs6.txt
+../Debug/GraphCreator -F test7.json -l -a hybrid-bfs -S V0 -T V1 > results/test_results_hbfs7.txt
+../Debug/GraphCreator -F test0.json -l -a parallel-bfs -S V0 -T V0 > results/test_results_pbfs0.txt
+../Debug/GraphCreator -F test1.json -l -a parallel-bfs -S V0 -T V0 > results/test_results_pbfs1.txt
+../Debug/GraphCreator -F test2.json -l -a parallel-bfs -S V0 -T V1 > results/test_results_pbfs2.txt
+../Debug/GraphCreator -F test3.json -l -a parallel-bfs -S V0 -T V1 > results/test_results_pbfs3.txt
+../Debug/GraphCreator -F test4.json -l -a parallel-bfs -S V0 -T V1 > results/test_results_pbfs4.txt
+../Debug/GraphCreator -F test5.json -l -a parallel-bfs -S V0 -T V1 > results/test_results_pbfs5.txt
+../Debug/GraphCreator -F test6.json -l -a parallel-bfs -S V0 -T V1 > results/test_results_pbfs6.txt
+../Debug/GraphCreator -F test7.json -l -a parallel-bfs -S V0 -T V1 > results/test_results_pbfs7.txt
+../Debug/GraphCreator -F test0.json -l -a bidirectional-bfs -S V0 -T V0 > results/test_results_bbfs0.txt
+../Debug/GraphCreator -F test1.json -l -a bidirectional-bfs -S V0 -T V0 > results/test_results_bbfs1.txt
+../Debug/GraphCreator -F test2.json -l -a bidirectional-bfs -S V0 -T V1 > results/test_results_bbfs2.txt
+../Debug/GraphCreator -F test3.json -l -a bidirectional-bfs -S V0 -T V1 > results/test_results_bbfs3.txt
+../Debug/GraphCreator -F test4.json -l -a bidirectional-bfs -S V0 -T V1 > results/test_results_bbfs4.txt
+../Debug/GraphCreator -F test5.json -l -a bidirectional-bfs -S V0 -T V1 > results/test_results_bbfs5.txt
+../Debug/GraphCreator -F test6.json -l -a bidirectional-bfs -S V0 -T V1 > results/test_results_bbfs6.txt
+../Debug/GraphCreator -F test7.json -l -a bidirectional-bfs -S V0 -T V1 > results/test_results_bbfs7.txt
+../Debug/GraphCreator -F test0.json -l -a astar -S V0 -T V0 > results/test_results_astar0.txt
+../Debug/GraphCreator -F test1.json -l -a astar -S V0 -T V0 > results/test_results_astar1.txt
+../Debug/GraphCreator -F test2.json -l -a astar -S V0 -T V1 > results/test_results_astar2.txt
+../Debug/GraphCreator -F test3.json -l -a astar -S V0 -T V1 > results/test_results_astar3.txt
+../Debug/GraphCreator -F test4.json -l -a astar -S V0 -T V1 > results/test_results_astar4.txt
+../Debug/GraphCreator -F test5.json -l -a astar -S V0 -T V1 > results/test_results_astar5.txt
+../Debug/GraphCreator -F test6.json -l -a astar -S V0 -T V1 > results/test_results_astar6.txt
+../Debug/GraphCreator -F test7.json -l -a astar -S V0 -T V1 > results/test_results_astar7.txt
+../Debug/GraphCreator -F test0.json -l -c -a astar -S V0 -T V0 > results/test_results_csr_astar0.txt
+../Debug/GraphCreator -F test1.json -l -c -a astar -S V0 -T V0 > results/test_results_csr_astar1.txt
+../Debug/GraphCreator -F test2.json -l -c -a astar -S V0 -T V1 > results/test_results_csr_astar2.txt
+../Debug/GraphCreator -F test3.json -l -c -a astar -S V0 -T V1 > results/test_results_csr_astar3.txt
+../Debug/GraphCreator -F test4.json -l -c -a astar -S V0 -T V1 > results/test_results_csr_astar4.txt
+../Debug/GraphCreator -F test5.json -l -c -a astar -S V0 -T V1 > results/test_results_csr_astar5.txt
+../Debug/GraphCreator -F test6.json -l -c -a astar -S V0 -T V1 > results/test_results_csr_astar6.txt
+../Debug/GraphCreator -F test7.json -l -c -a astar -S V0 -T V1 > results/test_results_csr_astar7.txt
+../Debug/GraphCreator -F test0.json -l -a alt -S V0 -T V0 > results/test_results_alt0.txt
+../Debug/GraphCreator -F test1.json -l -a alt -S V0 -T V0 > results/test_results_alt1.txt
+../Debug/GraphCreator -F test2.json -l -a alt -S V0 -T V1 > results/test_results_alt2.txt
+../Debug/GraphCreator -F test3.json -l -a alt -S V0 -T V1 > results/test_results_alt3.txt
+../Debug/GraphCreator -F test4.json -l -a alt -S V0 -T V1 > results/test_results_alt4.txt
+../Debug/GraphCreator -F test5.json -l -a alt -S V0 -T V1 > results/test_results_alt5.txt
+../Debug/GraphCreator -F test6.json -l -a alt -S V0 -T V1 > results/test_results_alt6.txt
+../Debug/GraphCreator -F test7.json -l -a alt -S V0 -T V1 > results/test_results_alt7.txt
+../Debug/GraphCreator -F test0.json -l -a bidirectional-alt -S V0 -T V0 > results/test_results_balt0.txt
+../Debug/GraphCreator -F test1.json -l -a bidirectional-alt -S V0 -T V0 > results/test_results_balt1.txt
+../Debug/GraphCreator -F test2.json -l -a bidirectional-alt -S V0 -T V1 > results/test_results_balt2.txt
+../Debug/GraphCreator -F test3.json -l -a bidirectional-alt -S V0 -T V1 > results/test_results_balt3.txt
+../Debug/GraphCreator -F test4.json -l -a bidirectional-alt -S V0 -T V1 > results/test_results_balt4.txt
+../Debug/GraphCreator -F test5.json -l -a bidirectional-alt -S V0 -T V1 > results/test_results_balt5.txt
+../Debug/GraphCreator -F test6.json -l -a bidirectional-alt -S V0 -T V1 > results/test_results_balt6.txt
+../Debug/GraphCreator -F test7.json -l -a bidirectional-alt -S V0 -T V1 > results/test_results_balt7.txt
+../Debug/GraphCreator -F test0.json -l -a ch -S V0 -T V0 > results/test_results_ch0.txt
+../Debug/GraphCreator -F test1.json -l -a ch -S V0 -T V0 > results/test_results_ch1.txt
+../Debug/GraphCreator -F test2.json -l -a ch -S V0 -T V1 > results/test_results_ch2.txt
+../Debug/GraphCreator -F test3.json -l -a ch -S V0 -T V1 > results/test_results_ch3.txt
+../Debug/GraphCreator -F test4.json -l -a ch -S V0 -T V1 > results/test_results_ch4.txt
+../Debug/GraphCreator -F test5.json -l -a ch -S V0 -T V1 > results/test_results_ch5.txt
+../Debug/GraphCreator -F test6.json -l -a ch -S V0 -T V1 > results/test_results_ch6.txt
+../Debug/GraphCreator -F test7.json -l -a ch -S V0 -T V1 > results/test_results_ch7.txt
+../Debug/GraphCreator -F test0.json -l -a hub-labels -S V0 -T V0 > results/test_results_hl0.txt
+../Debug/GraphCreator -F test1.json -l -a hub-labels -S V0 -T V0 > results/test_results_hl1.txt
+../Debug/GraphCreator -F test2.json -l -a hub-labels -S V0 -T V1 > results/test_results_hl2.txt
+../Debug/GraphCreator -F test3.json -l -a hub-labels -S V0 -T V1 > results/test_results_hl3.txt
+../Debug/GraphCreator -F test4.json -l -a hub-labels -S V0 -T V1 > results/test_results_hl4.txt
+../Debug/GraphCreator -F test5.json -l -a hub-labels -S V0 -T V1 > results/test_results_hl5.txt
+../Debug/GraphCreator -F test6.json -l -a hub-labels -S V0 -T V1 > results/test_results_hl6.txt
+../Debug/GraphCreator -F test7.json -l -a hub-labels -S V0 -T V1 > results/test_results_hl7.txt
+../Debug/GraphCreator -F test0.json -l -a spfa -S V0 -T V0 > results/test_results_spfa0.txt
+../Debug/GraphCreator -F test1.json -l -a spfa -S V0 -T V0 > results/test_results_spfa1.txt
+../Debug/GraphCreator -F test2.json -l -a spfa -S V0 -T V1 > results/test_results_spfa2.txt
+../Debug/GraphCreator -F test3.json -l -a spfa -S V0 -T V1 > results/test_results_spfa3.txt
+../Debug/GraphCreator -F test4.json -l -a spfa -S V0 -T V1 > results/test_results_spfa4.txt
+../Debug/GraphCreator -F test5.json -l -a spfa -S V0 -T V1 > results/test_results_spfa5.txt
+../Debug/GraphCreator -F test6.json -l -a spfa -S V0 -T V1 > results/test_results_spfa6.txt
+../Debug/GraphCreator -F test7.json -l -a spfa -S V0 -T V1 > results/test_results_spfa7.txt
+../Debug/GraphCreator -F test0.json -l -a spfa -c -S V0 -T V0 > results/test_results_csr_spfa0.txt
+../Debug/GraphCreator -F test1.json -l -a spfa -c -S V0 -T V0 > results/test_results_csr_spfa1.txt
+../Debug/GraphCreator -F test2.json -l -a spfa -c -S V0 -T V1 > results/test_results_csr_spfa2.txt
+../Debug/GraphCreator -F test3.json -l -a spfa -c -S V0 -T V1 > results/test_results_csr_spfa3.txt
+../Debug/GraphCreator -F test4.json -l -a spfa -c -S V0 -T V1 > results/test_results_csr_spfa4.txt
+../Debug/GraphCreator -F test5.json -l -a spfa -c -S V0 -T V1 > results/test_results_csr_spfa5.txt
+../Debug/GraphCreator -F test6.json -l -a spfa -c -S V0 -T V1 > results/test_results_csr_spfa6.txt
+../Debug/GraphCreator -F test7.json -l -a spfa -c -S V0 -T V1 > results/test_results_csr_spfa7.txt
+../Debug/GraphCreator -F test0.json -l -a parallel-bellman-ford -S V0 -T V0 > results/test_results_pbf0.txt
+../Debug/GraphCreator -F test1.json -l -a parallel-bellman-ford -S V0 -T V0 > results/test_results_pbf1.txt
+../Debug/GraphCreator -F test2.json -l -a parallel-bellman-ford -S V0 -T V1 > results/test_results_pbf2.txt
+../Debug/GraphCreator -F test3.json -l -a parallel-bellman-ford -S V0 -T V1 > results/test_results_pbf3.txt
+../Debug/GraphCreator -F test4.json -l -a parallel-bellman-ford -S V0 -T V1 > results/test_results_pbf4.txt
+../Debug/GraphCreator -F test5.json -l -a parallel-bellman-ford -S V0 -T V1 > results/test_results_pbf5.txt
+../Debug/GraphCreator -F test6.json -l -a parallel-bellman-ford -S V0 -T V1 > results/test_results_pbf6.txt
+../Debug/GraphCreator -F test7.json -l -a parallel-bellman-ford -S V0 -T V1 > results/test_results_pbf7.txt
+../Debug/GraphCreator -F test0.json -l -a dijkstra -R -S V0 -T V0 > results/test_results_rw0.txt
+../Debug/GraphCreator -F test1.json -l -a dijkstra -R -S V0 -T V0 > results/test_results_rw1.txt
+../Debug/GraphCreator -F test2.json -l -a dijkstra -R -S V0 -T V1 > results/test_results_rw2.txt
+../Debug/GraphCreator -F test3.json -l -a dijkstra -R -S V0 -T V1 > results/test_results_rw3.txt
+../Debug/GraphCreator -F test4.json -l -a dijkstra -R -S V0 -T V1 > results/test_results_rw4.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -R -S V0 -T V1 > results/test_results_rw5.txt
+../Debug/GraphCreator -F test6.json -l -a dijkstra -R -S V0 -T V1 > results/test_results_rw6.txt
+../Debug/GraphCreator -F test7.json -l -a dijkstra -R -S V0 -T V1 > results/test_results_rw7.txt
+../Debug/GraphCreator -F test0.json -l -a apsp -S V0 -T V0 > results/test_results_apsp0.txt
+../Debug/GraphCreator -F test1.json -l -a apsp -S V0 -T V0 > results/test_results_apsp1.txt
+../Debug/GraphCreator -F test2.json -l -a apsp -S V0 -T V1 > results/test_results_apsp2.txt
+../Debug/GraphCreator -F test3.json -l -a apsp -S V0 -T V1 > results/test_results_apsp3.txt
+../Debug/GraphCreator -F test4.json -l -a apsp -S V0 -T V1 > results/test_results_apsp4.txt
+../Debug/GraphCreator -F test5.json -l -a apsp -S V0 -T V1 > results/test_results_apsp5.txt
+../Debug/GraphCreator -F test6.json -l -a apsp -S V0 -T V1 > results/test_results_apsp6.txt
+../Debug/GraphCreator -F test7.json -l -a apsp -S V0 -T V1 > results/test_results_apsp7.txt
+../Debug/GraphCreator -F test0.json -l -a apsp -A dijkstra -S V0 -T V0 > results/test_results_apspd0.txt
+../Debug/GraphCreator -F test1.json -l -a apsp -A dijkstra -S V0 -T V0 > results/test_results_apspd1.txt
+../Debug/GraphCreator -F test2.json -l -a apsp -A dijkstra -S V0 -T V1 > results/test_results_apspd2.txt
+../Debug/GraphCreator -F test3.json -l -a apsp -A dijkstra -S V0 -T V1 > results/test_results_apspd3.txt
+../Debug/GraphCreator -F test4.json -l -a apsp -A dijkstra -S V0 -T V1 > results/test_results_apspd4.txt
+../Debug/GraphCreator -F test5.json -l -a apsp -A dijkstra -S V0 -T V1 > results/test_results_apspd5.txt
+../Debug/GraphCreator -F test6.json -l -a apsp -A dijkstra -S V0 -T V1 > results/test_results_apspd6.txt
+../Debug/GraphCreator -F test7.json -l -a apsp -A dijkstra -S V0 -T V1 > results/test_results_apspd7.txt
+../Debug/GraphCreator -F test5.json -l -a ch -Q query.txt > results/test_results_m2m_ch5.txt
+../Debug/GraphCreator -F test5.json -l -a apsp -Q query.txt > results/test_results_m2m_apsp5.txt
+../Debug/GraphCreator -F test7.json -l -a ch -Q query.txt > results/test_results_m2m_ch7.txt
+../Debug/GraphCreator -F test7.json -l -a apsp -Q query.txt > results/test_results_m2m_apsp7.txt
+../Debug/GraphCreator -F test6.json -l -a apsp -Q query.txt > results/test_results_m2m_apsp6.txt
+../Debug/GraphCreator -F test0.json -l -a dijkstra -S V0 > results/test_results_sssp0.txt
+../Debug/GraphCreator -F test1.json -l -a dijkstra -S V0 > results/test_results_sssp1.txt
+../Debug/GraphCreator -F test2.json -l -a dijkstra -S V0 > results/test_results_sssp2.txt
+../Debug/GraphCreator -F test3.json -l -a dijkstra -S V0 > results/test_results_sssp3.txt
+../Debug/GraphCreator -F test4.json -l -a dijkstra -S V0 > results/test_results_sssp4.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -S V0 > results/test_results_sssp5.txt
+../Debug/GraphCreator -F test6.json -l -a dijkstra -S V0 > results/test_results_sssp6.txt
+../Debug/GraphCreator -F test7.json -l -a dijkstra -S V0 > results/test_results_sssp7.txt
+../Debug/GraphCreator -F test0.json -l -a dijkstra -c -p dary -q -S V0 > results/test_results_csr_sssp0.txt
+../Debug/GraphCreator -F test1.json -l -a dijkstra -c -p dary -q -S V0 > results/test_results_csr_sssp1.txt
+../Debug/GraphCreator -F test2.json -l -a dijkstra -c -p dary -q -S V0 > results/test_results_csr_sssp2.txt
+../Debug/GraphCreator -F test3.json -l -a dijkstra -c -p dary -q -S V0 > results/test_results_csr_sssp3.txt
+../Debug/GraphCreator -F test4.json -l -a dijkstra -c -p dary -q -S V0 > results/test_results_csr_sssp4.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -c -p dary -q -S V0 > results/test_results_csr_sssp5.txt
+../Debug/GraphCreator -F test6.json -l -a dijkstra -c -p dary -q -S V0 > results/test_results_csr_sssp6.txt
+../Debug/GraphCreator -F test7.json -l -a dijkstra -c -p dary -q -S V0 > results/test_results_csr_sssp7.txt
+../Debug/GraphCreator -F test0.json -l -a dijkstra -C -S V0 > results/test_results_compact0.txt
+../Debug/GraphCreator -F test1.json -l -a dijkstra -C -S V0 > results/test_results_compact1.txt
+../Debug/GraphCreator -F test2.json -l -a dijkstra -C -S V0 > results/test_results_compact2.txt
+../Debug/GraphCreator -F test3.json -l -a dijkstra -C -S V0 > results/test_results_compact3.txt
+../Debug/GraphCreator -F test4.json -l -a dijkstra -C -S V0 > results/test_results_compact4.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -C -S V0 > results/test_results_compact5.txt
+../Debug/GraphCreator -F test6.json -l -a dijkstra -C -S V0 > results/test_results_compact6.txt
+../Debug/GraphCreator -F test7.json -l -a dijkstra -C -S V0 > results/test_results_compact7.txt
+../Debug/GraphCreator -F test0.json -l -a dijkstra -c -p dary -C -S V0 > results/test_results_csr_compact0.txt
+../Debug/GraphCreator -F test1.json -l -a dijkstra -c -p dary -C -S V0 > results/test_results_csr_compact1.txt
+../Debug/GraphCreator -F test2.json -l -a dijkstra -c -p dary -C -S V0 > results/test_results_csr_compact2.txt
+../Debug/GraphCreator -F test3.json -l -a dijkstra -c -p dary -C -S V0 > results/test_results_csr_compact3.txt
+../Debug/GraphCreator -F test4.json -l -a dijkstra -c -p dary -C -S V0 > results/test_results_csr_compact4.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -c -p dary -C -S V0 > results/test_results_csr_compact5.txt
+../Debug/GraphCreator -F test6.json -l -a dijkstra -c -p dary -C -S V0 > results/test_results_csr_compact6.txt
+../Debug/GraphCreator -F test7.json -l -a dijkstra -c -p dary -C -S V0 > results/test_results_csr_compact7.txt
+../Debug/GraphCreator -F test0.json -l -a dijkstra -j -S V0 -T V0 > results/test_results_stream0.txt
+../Debug/GraphCreator -F test1.json -l -a dijkstra -j -S V0 -T V0 > results/test_results_stream1.txt
+../Debug/GraphCreator -F test2.json -l -a dijkstra -j -S V0 -T V1 > results/test_results_stream2.txt
+../Debug/GraphCreator -F test3.json -l -a dijkstra -j -S V0 -T V1 > results/test_results_stream3.txt
+../Debug/GraphCreator -F test4.json -l -a dijkstra -j -S V0 -T V1 > results/test_results_stream4.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -j -S V0 -T V1 > results/test_results_stream5.txt
+../Debug/GraphCreator -F test6.json -l -a dijkstra -j -S V0 -T V1 > results/test_results_stream6.txt
+../Debug/GraphCreator -F test7.json -l -a dijkstra -j -S V0 -T V1 > results/test_results_stream7.txt
+../Debug/GraphCreator -F test0.json -l -a dijkstra -c -j -S V0 -T V0 > results/test_results_csr_stream0.txt
+../Debug/GraphCreator -F test1.json -l -a dijkstra -c -j -S V0 -T V0 > results/test_results_csr_stream1.txt
+../Debug/GraphCreator -F test2.json -l -a dijkstra -c -j -S V0 -T V1 > results/test_results_csr_stream2.txt
+../Debug/GraphCreator -F test3.json -l -a dijkstra -c -j -S V0 -T V1 > results/test_results_csr_stream3.txt
+../Debug/GraphCreator -F test4.json -l -a dijkstra -c -j -S V0 -T V1 > results/test_results_csr_stream4.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -c -j -S V0 -T V1 > results/test_results_csr_stream5.txt
+../Debug/GraphCreator -F test6.json -l -a dijkstra -c -j -S V0 -T V1 > results/test_results_csr_stream6.txt
+../Debug/GraphCreator -F test7.json -l -a dijkstra -c -j -S V0 -T V1 > results/test_results_csr_stream7.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -S V0 -T NOSUCH > results/test_results_unknown_target.txt
+../Debug/GraphCreator -F test5.json -l -a dijkstra -c -S V0 -T NOSUCH > results/test_results_csr_unknown_target.txt
+../Debug/GraphCreator -F test5.json -l -a dial -c -S V0 -T NOSUCH > results/test_results_csr_dial_unknown_target.txt
+../Debug/GraphCreator -F test8.json -l -a dijkstra -p radix -S V0 -T V1 > results/test_results_radix_d8.txt
+../Debug/GraphCreator -F test8.json -l -a fast-dijkstra -p radix -S V0 -T V1 > results/test_results_radix_fd8.txt
+../Debug/GraphCreator -F test8.json -l -a fast-dijkstra -c -p radix -S V0 -T V1 > results/test_results_csr_radix_fd8.txt
+../Debug/GraphCreator -F test9.json -l -a delta-stepping -S V0 -T V1 > results/test_results_ds9.txt
+../Debug/GraphCreator -F test9.json -l -a bellman-ford -c -S V0 -T V1 > results/test_results_bf9.txt
\ No newline at end of file